@@ -0,0 +1,85 @@
+// Counts heap allocations made by the model getters on the hot UI paths:
+// one simulated frame reads every cell of the visible rows of the student
+// and staff tables plus the open profile modal, the way App.cpp does.
+//
+//   make bench && ./bench/AllocBench
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include "Models/Staff.h"
+#include "Models/Student.h"
+#include "Models/StudentTable.h"
+
+static std::atomic<size_t> allocations{0};
+
+// All out of line so GCC does not pair an inlined malloc() or free() with the
+// other operator and warn
+[[gnu::noinline]] void* operator new(size_t size) {
+    ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static size_t sink = 0;
+static void Cell(const char* text) { sink += std::strlen(text); } // Stands in for ImGui::Text("%s", ...)
+static void Cell(int value) { sink += static_cast<size_t>(value); }
+
+int main() {
+    const int kRecords = 10000;
+    const int kVisibleRows = 40; // What the ListClipper submits on a typical window
+    const int kFrames = 10000;
+
+    StudentTable students;
+    std::vector<Staff> staff;
+    for (int i = 0; i < kRecords; ++i) {
+        std::string n = std::to_string(i);
+        students.Append(Student(i, "Student Number " + n, "student" + n + "@example-school.edu", "+91 98765 4" + n,
+                                "10", "A", "Guardian Of Student " + n));
+        staff.push_back(Staff(i, "Staff Member " + n, "staff" + n + "@example-school.edu", "+91 98765 4" + n,
+                              i % 3 ? "Teacher" : "Administrative Clerk", "Mathematics"));
+    }
+    Student profile(0, "Profile Student Name", "profile.student@example-school.edu", "+91 98765 43210",
+                    "10", "A", "Profile Guardian Name");
+
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < kFrames; ++frame) {
+        int first = (frame * 7) % (kRecords - kVisibleRows);
+        for (int row = first; row < first + kVisibleRows; ++row) {
+            StudentTable::ConstRow s = students[row];
+            Cell(s.getRollNumber());
+            Cell(s.getName().c_str());
+            Cell(s.getClassName().c_str());
+            Cell(s.getSection().c_str());
+            Cell(s.getFatherName().c_str());
+
+            const Staff& t = staff[row];
+            Cell(t.getId());
+            Cell(t.getName().c_str());
+            Cell(t.getRole().c_str());
+            Cell(t.getSubject().c_str());
+            Cell(t.getPhone().c_str());
+            Cell(t.getEmail().c_str());
+        }
+        Cell(profile.getName().c_str());
+        Cell(profile.getFatherName().c_str());
+        Cell(profile.getPhone().c_str());
+        Cell(profile.getEmail().c_str());
+        Cell(profile.getClassName().c_str());
+        Cell(profile.getSection().c_str());
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    size_t count = allocations - before;
+
+    std::printf("frames: %d, rows per table: %d\n", kFrames, kVisibleRows);
+    std::printf("allocations per frame: %.1f\n", double(count) / kFrames);
+    std::printf("time per frame: %.3f us\n", ms * 1000.0 / kFrames);
+    return sink == 0; // Keep the reads observable
+}
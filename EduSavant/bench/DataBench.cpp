@@ -0,0 +1,339 @@
+// Times the DataManager operations that scale with the roster on synthetic
+// schools of increasing size and prints the results as JSON: wall time,
+// heap allocations (all threads, so the persistence worker counts) and peak
+// resident memory per benchmark.
+//
+//   make bench && ./bench/DataBench --sizes 1000,10000 --out results.json
+//
+// Each size runs in a scratch directory under the system temp directory.
+// Peak RSS is reset between benchmarks through /proc/self/clear_refs where
+// the kernel supports it; elsewhere it is the process-wide peak so far.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include "DataManager.h"
+#include "Storage/CsvImport.h"
+#include "SyntheticData.h"
+
+static std::atomic<size_t> allocations{0};
+static std::atomic<size_t> allocatedBytes{0};
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+// Out of line so GCC does not pair the inlined free() with operator new and warn
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Result {
+    int students = 0;
+    std::string name;
+    size_t ops = 0;
+    double seconds = 0.0;
+    size_t allocations = 0;
+    size_t bytes = 0;
+    long peakRssKb = 0;
+};
+
+size_t sink = 0; // Keeps measured reads observable
+bool mismatch = false; // A benchmark that checks its output found it wrong
+
+void ResetPeakRss() {
+    if (FILE* f = std::fopen("/proc/self/clear_refs", "w")) {
+        std::fputs("5", f);
+        std::fclose(f);
+    }
+}
+
+long PeakRssKb() {
+    if (FILE* f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        long kb = -1;
+        while (kb < 0 && std::fgets(line, sizeof(line), f))
+            if (std::strncmp(line, "VmHWM:", 6) == 0) kb = std::atol(line + 6);
+        std::fclose(f);
+        if (kb >= 0) return kb;
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+template <typename Fn>
+Result Measure(int students, const char* name, size_t ops, Fn&& fn) {
+    ResetPeakRss();
+    size_t allocationsBefore = allocations.load();
+    size_t bytesBefore = allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    Result r;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    r.students = students;
+    r.name = name;
+    r.ops = ops;
+    r.allocations = allocations.load() - allocationsBefore;
+    r.bytes = allocatedBytes.load() - bytesBefore;
+    r.peakRssKb = PeakRssKb();
+    std::fprintf(stderr, "%8d  %-26s %10.3f ms\n", students, name, r.seconds * 1000.0);
+    return r;
+}
+
+// What RenderDashboard reads each frame.
+void ReadDashboard(const DataManager& data) {
+    const RosterStats& stats = data.Stats();
+    sink += stats.Count() + size_t(stats.MeanAttendance() + stats.MinAttendance() + stats.MaxAttendance());
+    const ClassConfig& config = ClassConfig::Get();
+    for (ClassId cls : config.Classes()) {
+        for (SectionId sec : config.Sections(cls))
+            sink += stats.Section(config.Class(cls).symbol, config.Section(sec).symbol).count;
+    }
+    for (const RosterStats::SubjectRow& row : stats.Subjects())
+        for (const RosterStats::Score& score : row.terms) sink += score.count;
+}
+
+// Field-by-field comparison of what the CSV importer parsed with what was
+// written; reports the first difference.
+bool SameStudents(const StudentTable& parsed, const StudentTable& written) {
+    if (parsed.size() != written.size()) {
+        std::fprintf(stderr, "import_csv: parsed %zu rows, wrote %zu\n", parsed.size(), written.size());
+        return false;
+    }
+    for (int slot = 0; slot < static_cast<int>(written.size()); ++slot) {
+        StudentTable::ConstRow a = parsed[slot], b = written[slot];
+        bool same = a.getId() == b.getId() && a.getName() == b.getName() && a.getFatherName() == b.getFatherName() &&
+                    a.getEmail() == b.getEmail() && a.getPhone() == b.getPhone() &&
+                    a.getClassSymbol() == b.getClassSymbol() && a.getSectionSymbol() == b.getSectionSymbol() &&
+                    a.getAttendance() == b.getAttendance() && a.getMarks().Count() == b.getMarks().Count();
+        b.getMarks().ForEach([&](int term, Symbol subject, int mark) { same = same && a.getMarks().Peek(term, subject) == mark; });
+        if (!same) {
+            std::fprintf(stderr, "import_csv: row %d parsed as \"%s\" / \"%s\", wrote \"%s\" / \"%s\"\n", slot,
+                         a.getName().c_str(), a.getFatherName().c_str(), b.getName().c_str(), b.getFatherName().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+void RunSize(const Synthetic::Spec& spec, std::vector<Result>& results) {
+    const int n = spec.students;
+    namespace fs = std::filesystem;
+    fs::path previous = fs::current_path();
+    fs::path dir = fs::temp_directory_path() / ("edusavant-bench-" + std::to_string(n));
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::current_path(dir);
+
+    Synthetic::Configure(spec);
+    StudentTable rows;
+    results.push_back(Measure(n, "generate", n, [&] { rows = Synthetic::Students(spec); }));
+
+    // The parallel CSV parse, checked row by row. Every line has several
+    // ""-escaped fields, short ones (held inline by std::string) first.
+    {
+        StudentTable written = rows;
+        auto nickname = [](int i) {
+            return std::string(Synthetic::kFirstNames[i % std::size(Synthetic::kFirstNames)]) + " \"" +
+                   std::to_string(i % 100) + "\"";
+        };
+        for (int slot = 0; slot < n; ++slot) {
+            StudentTable::Row s = written[slot];
+            s.setName(nickname(slot));
+            s.setFatherName(nickname(slot / 7));
+            s.setEmail("\"" + s.getEmail() + "\"");
+        }
+        Synthetic::WriteCsv("students.csv", written, spec);
+        std::unique_ptr<Storage::CsvStudentImport> import;
+        results.push_back(Measure(n, "import_csv", n, [&] {
+            import = std::make_unique<Storage::CsvStudentImport>("students.csv", ClassConfig::Get());
+            while (!import->Finished()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }));
+        if (!import->Failure().empty()) std::fprintf(stderr, "import_csv: %s\n", import->Failure().c_str());
+        if (!import->Failure().empty() || !SameStudents(import->Rows(), written)) mismatch = true;
+    }
+    {
+        DataManager data; // Empty directory: starts with no roster
+        data.SaveClassConfig();
+        for (const Staff& s : Synthetic::StaffMembers(spec)) data.AddStaff(s);
+        data.Flush();
+
+        StudentTable again = rows;
+        results.push_back(Measure(n, "import_students", n, [&] {
+            data.ImportStudents(rows);
+            data.Flush();
+        }));
+        // The UI thread's share of importing the same file again: every row
+        // replaces a student, and the indexes are built in the background
+        results.push_back(Measure(n, "reimport_students_begin", n, [&] { data.BeginImport(again); }));
+        data.FinishImport(true);
+        data.Flush();
+        results.push_back(Measure(n, "save_students", n, [&] {
+            data.SaveStudents();
+            data.Flush();
+        }));
+        // What Pump() does on the UI thread to hand a roster snapshot to the
+        // writer, then the first edit to a row the snapshot still shares
+        const int copies = 100;
+        results.push_back(Measure(n, "snapshot_handoff", copies, [&] {
+            for (int i = 0; i < copies; ++i) {
+                StudentTable snapshot = data.students;
+                sink += snapshot.size();
+            }
+        }));
+        results.push_back(Measure(n, "edit_shared_row", copies, [&] {
+            for (int i = 0; i < copies; ++i) {
+                StudentTable snapshot = data.students;
+                data.SetStudentAttendance(data.students.Ids()[(i * 7919) % n], float(i % 100));
+            }
+            data.Flush();
+        }));
+        results.push_back(Measure(n, "load_students", n, [&] { data.LoadStudents(); }));
+        results.push_back(Measure(n, "recalculate_roll_numbers", n, [&] { data.RecalculateRollNumbers(); }));
+
+        // Single-record edits, each journaled; Flush() includes the disk writes
+        const int edits = std::min(n, 10000);
+        Synthetic::Rng rng(spec.seed + 1);
+        std::vector<Student> added;
+        added.reserve(edits);
+        for (int i = 0; i < edits; ++i) added.push_back(Synthetic::MakeStudent(spec, rng, data.getNextStudentId() + i));
+        results.push_back(Measure(n, "add_student", edits, [&] {
+            for (const Student& s : added) data.AddStudent(s);
+            data.Flush();
+        }));
+        std::vector<int> ids(data.students.Ids().begin(), data.students.Ids().end());
+        for (int i = 0; i < edits; ++i) std::swap(ids[i], ids[i + rng.Below(static_cast<int>(ids.size()) - i)]);
+        results.push_back(Measure(n, "delete_student", edits, [&] {
+            for (int i = 0; i < edits; ++i) data.DeleteStudent(ids[i]);
+            data.Flush();
+        }));
+
+        // Whole names, partial words, a typo, email and phone fragments, a miss
+        static const char* const kQueries[] = {
+            "Sharma", "priya", "aarav thapa", "Shrestah", "koir", "school.edu", "98012", "qxzv",
+        };
+        const int rounds = 10;
+        results.push_back(Measure(n, "search_students", rounds * std::size(kQueries), [&] {
+            for (int round = 0; round < rounds; ++round)
+                for (const char* q : kQueries) sink += data.SearchStudents(q).size();
+        }));
+
+        results.push_back(Measure(n, "dashboard_rebuild", n, [&] {
+            RosterStats stats;
+            stats.Rebuild(data.students);
+            sink += stats.Count();
+        }));
+        const int frames = 1000;
+        results.push_back(Measure(n, "dashboard_read", frames, [&] {
+            for (int frame = 0; frame < frames; ++frame) ReadDashboard(data);
+        }));
+        results.push_back(Measure(n, "mark_analytics", n, [&] {
+            sink += MarkAnalytics::Compute(data.students, data.Sections(), ClassConfig::Get()).school.students;
+        }));
+        data.Analytics(true);
+        results.push_back(Measure(n, "mark_analytics_cached", frames, [&] {
+            for (int frame = 0; frame < frames; ++frame) sink += data.Analytics().school.students;
+        }));
+        // The UI thread's share of a recompute: a mark edit, then the frame
+        // that hands snapshots to the background thread
+        const int markEdits = 100;
+        const Symbol subject = ClassConfig::Get().Subjects(ClassConfig::Get().Sections(ClassConfig::Get().Classes()[0])[0])[0];
+        results.push_back(Measure(n, "mark_analytics_request", markEdits, [&] {
+            for (int i = 0; i < markEdits; ++i) {
+                data.SetStudentMark(data.students.Ids()[(i * 7919) % n], 1, subject, i % 101);
+                sink += data.Analytics().school.students;
+            }
+        }));
+        data.Analytics(true);
+    }
+
+    fs::current_path(previous);
+    fs::remove_all(dir);
+}
+
+void WriteJson(FILE* out, const Synthetic::Spec& spec, const std::vector<Result>& results) {
+    std::fprintf(out, "{\n  \"suite\": \"DataManager\",\n");
+    std::fprintf(out, "  \"spec\": {\"classes\": %d, \"sections_per_class\": %d, \"subjects_per_section\": %d, "
+                      "\"terms\": %d, \"staff\": %d, \"seed\": %llu},\n",
+                 spec.classes, spec.sectionsPerClass, spec.subjectsPerSection, spec.terms, spec.staff,
+                 static_cast<unsigned long long>(spec.seed));
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out, "    {\"students\": %d, \"benchmark\": \"%s\", \"ops\": %zu, \"seconds\": %.6f, "
+                          "\"ns_per_op\": %.1f, \"allocations\": %zu, \"allocated_bytes\": %zu, \"peak_rss_kb\": %ld}%s\n",
+                     r.students, r.name.c_str(), r.ops, r.seconds, r.ops ? r.seconds * 1e9 / r.ops : 0.0,
+                     r.allocations, r.bytes, r.peakRssKb, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: DataBench [--sizes 1000,10000,100000,1000000] [--classes N] [--sections N]\n"
+        "                 [--subjects N] [--terms N] [--staff N] [--seed N] [--out file.json]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Synthetic::Spec spec;
+    std::vector<int> sizes = { 1000, 10000, 100000, 1000000 };
+    const char* outPath = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (i + 1 == argc) {
+            PrintUsage();
+            return 1;
+        }
+        const char* value = argv[++i];
+        if (arg == "--sizes") {
+            sizes.clear();
+            std::stringstream list(value);
+            for (std::string item; std::getline(list, item, ',');) sizes.push_back(std::atoi(item.c_str()));
+        } else if (arg == "--classes") spec.classes = std::atoi(value);
+        else if (arg == "--sections") spec.sectionsPerClass = std::atoi(value);
+        else if (arg == "--subjects") spec.subjectsPerSection = std::atoi(value);
+        else if (arg == "--terms") spec.terms = std::atoi(value);
+        else if (arg == "--staff") spec.staff = std::atoi(value);
+        else if (arg == "--seed") spec.seed = std::strtoull(value, nullptr, 10);
+        else if (arg == "--out") outPath = value;
+        else {
+            PrintUsage();
+            return 1;
+        }
+    }
+    if (spec.classes < 1 || spec.sectionsPerClass < 1 || spec.subjectsPerSection < 0 || spec.terms < 0 || spec.staff < 0 ||
+        std::any_of(sizes.begin(), sizes.end(), [](int n) { return n < 1; })) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<Result> results;
+    for (int n : sizes) {
+        spec.students = n;
+        RunSize(spec, results);
+    }
+
+    FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Could not write %s\n", outPath);
+        return 1;
+    }
+    WriteJson(out, spec, results);
+    if (out != stdout) std::fclose(out);
+    return sink == 0 || mismatch;
+}
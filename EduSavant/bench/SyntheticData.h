@@ -0,0 +1,171 @@
+#pragma once
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "Core/SymbolTable.h"
+#include "Models/ClassConfig.h"
+#include "Models/MarkSheet.h"
+#include "Models/Staff.h"
+#include "Models/Student.h"
+#include "Models/StudentTable.h"
+
+// Deterministic school rosters for benchmarks. The same spec and seed give
+// byte-identical data on every platform: the generator is SplitMix64 with
+// its own range reduction rather than <random>'s distributions, whose
+// output is implementation-defined.
+namespace Synthetic {
+
+struct Spec {
+    int classes = 12;            // Named "1".."12"
+    int sectionsPerClass = 3;    // Named "A", "B", ...
+    int subjectsPerSection = 6;  // Drawn from kSubjects
+    int terms = MarkSheet::kTerms; // Terms 1..terms get marks
+    int students = 1000;
+    int staff = 100;
+    uint64_t seed = 2024;
+};
+
+class Rng {
+public:
+    explicit Rng(uint64_t seed) : state(seed) {}
+
+    uint64_t Next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform in [0, n); the modulo bias is irrelevant at these ranges.
+    int Below(int n) { return static_cast<int>(Next() % static_cast<uint64_t>(n)); }
+
+    template <typename T, size_t N>
+    const T& Pick(const T (&items)[N]) { return items[Below(static_cast<int>(N))]; }
+
+private:
+    uint64_t state;
+};
+
+inline const char* const kFirstNames[] = {
+    "Aarav", "Aayush", "Ananya", "Anish", "Bikash", "Deepa", "Gita", "Hari", "Ishaan", "Kabir",
+    "Kavya", "Laxmi", "Manish", "Meera", "Nabin", "Nisha", "Pooja", "Prakash", "Priya", "Rahul",
+    "Ramesh", "Riya", "Rohan", "Sagar", "Sanjay", "Sita", "Sunita", "Suresh", "Tara", "Vivek",
+};
+inline const char* const kLastNames[] = {
+    "Acharya", "Adhikari", "Bhandari", "Basnet", "Chaudhary", "Gurung", "Joshi", "Karki", "Khadka", "Koirala",
+    "Lama", "Magar", "Maharjan", "Pandey", "Poudel", "Rai", "Rana", "Sharma", "Shrestha", "Thapa",
+};
+inline const char* const kSubjects[] = {
+    "English", "Nepali", "Maths", "Science", "Social Studies", "Computer", "Health", "Accountancy",
+    "Economics", "Physics", "Chemistry", "Biology", "Optional Maths", "Moral Education",
+};
+
+inline std::string ClassName(int index) { return std::to_string(index + 1); }
+inline std::string SectionName(int index) { return std::string(1, char('A' + index % 26)) + (index >= 26 ? std::to_string(index / 26) : ""); }
+
+// Replaces ClassConfig::Get() with spec.classes x spec.sectionsPerClass
+// sections, each teaching a rotating window of subjects.
+inline void Configure(const Spec& spec) {
+    ClassConfig& config = ClassConfig::Get();
+    config.Clear();
+    const int subjectPool = static_cast<int>(std::size(kSubjects));
+    for (int c = 0; c < spec.classes; ++c) {
+        std::string cls = ClassName(c);
+        config.AddClass(cls);
+        for (int s = 0; s < spec.sectionsPerClass; ++s) {
+            std::string sec = SectionName(s);
+            config.AddSection(cls, sec);
+            for (int k = 0; k < spec.subjectsPerSection; ++k)
+                config.AddSubject(cls, sec, kSubjects[(c + s + k) % subjectPool]);
+        }
+    }
+}
+
+// One student with ID `id` placed in a random configured section, with a
+// mark for every subject of that section in every generated term.
+inline Student MakeStudent(const Spec& spec, Rng& rng, int id) {
+    std::string first = rng.Pick(kFirstNames);
+    std::string last = rng.Pick(kLastNames);
+    std::string cls = ClassName(rng.Below(spec.classes));
+    std::string sec = SectionName(rng.Below(spec.sectionsPerClass));
+    std::string digits = std::to_string(9800000000ull + rng.Next() % 100000000ull);
+    Student s(id, first + " " + last, first + "." + last + std::to_string(id) + "@school.edu.np", digits,
+              cls, sec, std::string(rng.Pick(kFirstNames)) + " " + last);
+    s.setAttendance(static_cast<float>(50 + rng.Below(451)) / 5.0f); // 10.0 .. 100.0 in 0.2 steps
+    const ClassConfig& config = ClassConfig::Get();
+    if (SectionId section = config.FindSection(cls, sec); section != kNoSection) {
+        for (int term = 1; term <= spec.terms; ++term)
+            for (Symbol subject : config.Subjects(section)) s.setMark(term, subject, 20 + rng.Below(81));
+    }
+    return s;
+}
+
+// Students with IDs firstId, firstId + 1, ... Call Configure() first.
+inline StudentTable Students(const Spec& spec, int firstId = 1) {
+    Rng rng(spec.seed);
+    StudentTable table;
+    table.reserve(spec.students);
+    for (int i = 0; i < spec.students; ++i) table.Append(MakeStudent(spec, rng, firstId + i));
+    return table;
+}
+
+// Writes the table in the CSV layout Storage::CsvStudentImport reads: every
+// text field quoted (quotes inside doubled), then one column per term and
+// subject, filled where the student has that mark.
+inline bool WriteCsv(const std::string& path, const StudentTable& students, const Spec& spec) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::string line = "id,name,father_name,email,phone,class,section,attendance";
+    std::vector<std::pair<int, Symbol>> marks;
+    for (int term = 1; term <= spec.terms; ++term) {
+        for (const char* subject : kSubjects) {
+            line += ",T" + std::to_string(term) + ":" + subject;
+            marks.push_back({ term, SymbolTable::Get().Intern(subject) });
+        }
+    }
+    line += '\n';
+    auto quote = [&line](const std::string& text) {
+        line += ",\"";
+        for (char c : text) line.append(c == '"' ? 2 : 1, c);
+        line += '"';
+    };
+    bool ok = std::fwrite(line.data(), 1, line.size(), file) == line.size();
+    for (int slot = 0; ok && slot < static_cast<int>(students.size()); ++slot) {
+        StudentTable::ConstRow s = students[slot];
+        line = std::to_string(s.getId());
+        for (const std::string* text : { &s.getName(), &s.getFatherName(), &s.getEmail(), &s.getPhone(),
+                                         &s.getClassName(), &s.getSection() })
+            quote(*text);
+        char number[32];
+        auto [end, ec] = std::to_chars(number, number + sizeof(number), s.getAttendance());
+        line += ',';
+        line.append(number, end);
+        for (const auto& [term, subject] : marks) {
+            line += ',';
+            int mark = s.getMarks().Peek(term, subject);
+            if (mark != MarkSheet::kNoMark) line += std::to_string(mark);
+        }
+        line += '\n';
+        ok = std::fwrite(line.data(), 1, line.size(), file) == line.size();
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+inline std::vector<Staff> StaffMembers(const Spec& spec) {
+    static const char* const kRoles[] = { "Teacher", "Teacher", "Teacher", "Coordinator", "Accountant", "Librarian" };
+    Rng rng(spec.seed ^ 0x5157AFFull);
+    std::vector<Staff> roster;
+    roster.reserve(spec.staff);
+    for (int i = 0; i < spec.staff; ++i) {
+        std::string first = rng.Pick(kFirstNames);
+        std::string last = rng.Pick(kLastNames);
+        roster.emplace_back(i + 1, first + " " + last, first + "." + last + "@school.edu.np",
+                            std::to_string(9700000000ull + rng.Next() % 100000000ull), rng.Pick(kRoles), rng.Pick(kSubjects));
+    }
+    return roster;
+}
+
+} // namespace Synthetic
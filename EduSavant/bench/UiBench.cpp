@@ -0,0 +1,216 @@
+// Renders App's screens for N frames against a synthetic roster on the
+// imgui_impl_null backend (no window, no GPU) and prints JSON per screen:
+// UI code time (App::RenderFrame), ImGui::Render time, vertices, indices,
+// draw commands, and heap allocations per frame, both through operator new
+// and through ImGui's own allocator.
+//
+//   make bench && ./bench/UiBench --students 10000 --frames 1000
+//
+// Times are wall clock on the calling thread; the UI is single-threaded.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "App.h"
+#include "UI/Theme.h"
+#include "imgui_impl_null.h"
+#include "SyntheticData.h"
+
+static std::atomic<size_t> allocations{0};
+static std::atomic<size_t> allocatedBytes{0};
+static size_t imguiAllocations = 0; // ImGui allocates on the UI thread only
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+// Out of line so GCC does not pair the inlined free() with operator new and warn
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static void* CountingImGuiAlloc(size_t size, void*) {
+    ++imguiAllocations;
+    return std::malloc(size);
+}
+static void ImGuiFree(void* p, void*) { std::free(p); }
+
+struct ScreenResult {
+    std::string name;
+    int frames = 0;
+    double uiUs = 0.0, uiUsP95 = 0.0, renderUs = 0.0;
+    double vertices = 0.0, indices = 0.0, drawCmds = 0.0;
+    double allocations = 0.0, bytes = 0.0, imguiAllocations = 0.0;
+};
+
+// Friend of App: selects screens and runs frames the way App::Run does,
+// minus the platform and GL calls.
+class UiBench {
+public:
+    explicit UiBench(App& app) : app(app) {}
+
+    void Populate(const Synthetic::Spec& spec) {
+        Synthetic::Configure(spec);
+        StudentTable rows = Synthetic::Students(spec);
+        app.dataManager.ImportStudents(rows);
+        for (const Staff& s : Synthetic::StaffMembers(spec)) app.dataManager.AddStaff(s);
+        app.dataManager.Flush();
+    }
+
+    std::vector<ScreenResult> MeasureScreens(int frames) {
+        std::vector<ScreenResult> results = {
+            Measure("dashboard", App::Screen::Dashboard, false, frames),
+            Measure("students", App::Screen::Students, false, frames),
+            Measure("staff", App::Screen::Teachers, false, frames),
+            Measure("settings", App::Screen::Settings, false, frames),
+            Measure("student_profile", App::Screen::Students, true, frames), // The list with the profile modal open
+        };
+        app.analyticsOpen = true; // Computed once up front, then read from the cache
+        app.dataManager.Analytics(true);
+        results.push_back(Measure("dashboard_analytics", App::Screen::Dashboard, false, frames));
+        app.analyticsOpen = false;
+        return results;
+    }
+
+private:
+    static constexpr int kWarmupFrames = 10;
+    struct FrameTimes { double ui, render; }; // Microseconds
+
+    ScreenResult Measure(const char* name, App::Screen screen, bool profile, int frames) {
+        app.currentScreen = screen;
+        app.selectedStudentId = profile && app.dataManager.students.size() ? app.dataManager.students[0].getId() : -1;
+        for (int i = 0; i < kWarmupFrames; ++i) Frame(); // Layout, fonts, popups opening, view caches
+
+        ScreenResult r;
+        r.name = name;
+        r.frames = frames;
+        std::vector<double> uiTimes;
+        uiTimes.reserve(frames);
+        for (int i = 0; i < frames; ++i) {
+            size_t allocationsBefore = allocations.load();
+            size_t bytesBefore = allocatedBytes.load();
+            size_t imguiBefore = imguiAllocations;
+            FrameTimes t = Frame();
+            r.allocations += allocations.load() - allocationsBefore;
+            r.bytes += allocatedBytes.load() - bytesBefore;
+            r.imguiAllocations += imguiAllocations - imguiBefore;
+            uiTimes.push_back(t.ui);
+            r.uiUs += t.ui;
+            r.renderUs += t.render;
+
+            const ImDrawData* draw = ImGui::GetDrawData();
+            r.vertices += draw->TotalVtxCount;
+            r.indices += draw->TotalIdxCount;
+            for (const ImDrawList* list : draw->CmdLists) r.drawCmds += list->CmdBuffer.Size;
+        }
+        for (double* v : { &r.uiUs, &r.renderUs, &r.vertices, &r.indices, &r.drawCmds, &r.allocations, &r.bytes, &r.imguiAllocations })
+            *v /= frames;
+        std::sort(uiTimes.begin(), uiTimes.end());
+        r.uiUsP95 = uiTimes[std::min(uiTimes.size() - 1, uiTimes.size() * 95 / 100)];
+        app.selectedStudentId = -1;
+        std::fprintf(stderr, "%-16s %9.1f us UI %9.1f us render %8.0f vertices %8.1f allocations/frame\n",
+                     name, r.uiUs, r.renderUs, r.vertices, r.allocations + r.imguiAllocations);
+        return r;
+    }
+
+    FrameTimes Frame() {
+        using Clock = std::chrono::steady_clock;
+        ImGui_ImplNull_NewFrame();
+        ImGui::NewFrame();
+        auto start = Clock::now();
+        app.RenderFrame();
+        auto built = Clock::now();
+        ImGui::Render();
+        ImGui_ImplNullRender_RenderDrawData(ImGui::GetDrawData());
+        auto end = Clock::now();
+        return { std::chrono::duration<double, std::micro>(built - start).count(),
+                 std::chrono::duration<double, std::micro>(end - built).count() };
+    }
+
+    App& app;
+};
+
+static void WriteJson(FILE* out, const Synthetic::Spec& spec, const std::vector<ScreenResult>& results) {
+    std::fprintf(out, "{\n  \"suite\": \"UI\",\n");
+    std::fprintf(out, "  \"spec\": {\"students\": %d, \"staff\": %d, \"classes\": %d, \"sections_per_class\": %d, "
+                      "\"subjects_per_section\": %d, \"seed\": %llu},\n",
+                 spec.students, spec.staff, spec.classes, spec.sectionsPerClass, spec.subjectsPerSection,
+                 static_cast<unsigned long long>(spec.seed));
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const ScreenResult& r = results[i];
+        std::fprintf(out, "    {\"screen\": \"%s\", \"frames\": %d, \"ui_us\": %.2f, \"ui_us_p95\": %.2f, \"render_us\": %.2f, "
+                          "\"vertices\": %.0f, \"indices\": %.0f, \"draw_cmds\": %.1f, \"allocations_per_frame\": %.2f, "
+                          "\"allocated_bytes_per_frame\": %.0f, \"imgui_allocations_per_frame\": %.2f}%s\n",
+                     r.name.c_str(), r.frames, r.uiUs, r.uiUsP95, r.renderUs, r.vertices, r.indices, r.drawCmds,
+                     r.allocations, r.bytes, r.imguiAllocations, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char** argv) {
+    Synthetic::Spec spec;
+    spec.students = 10000;
+    int frames = 1000;
+    const char* outPath = nullptr;
+    bool valid = argc % 2 == 1; // Options all take a value
+    for (int i = 1; valid && i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--students") spec.students = std::atoi(argv[i + 1]);
+        else if (arg == "--staff") spec.staff = std::atoi(argv[i + 1]);
+        else if (arg == "--frames") frames = std::atoi(argv[i + 1]);
+        else if (arg == "--seed") spec.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (arg == "--out") outPath = argv[i + 1];
+        else valid = false;
+    }
+    if (!valid || frames < 1 || spec.students < 0 || spec.staff < 0) {
+        std::fprintf(stderr, "Usage: UiBench [--students N] [--staff N] [--frames N] [--seed N] [--out file.json]\n");
+        return 1;
+    }
+
+    // App loads from the working directory; give it an empty scratch one
+    namespace fs = std::filesystem;
+    fs::path previous = fs::current_path();
+    fs::path dir = fs::temp_directory_path() / "edusavant-uibench";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    fs::current_path(dir);
+
+    ImGui::SetAllocatorFunctions(CountingImGuiAlloc, ImGuiFree);
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+    Theme::Setup();
+    ImGui_ImplNull_Init();
+
+    std::vector<ScreenResult> results;
+    {
+        auto app = std::make_unique<App>();
+        UiBench bench(*app);
+        bench.Populate(spec);
+        results = bench.MeasureScreens(frames);
+    }
+
+    ImGui_ImplNull_Shutdown();
+    ImGui::DestroyContext();
+    fs::current_path(previous);
+    fs::remove_all(dir);
+
+    FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Could not write %s\n", outPath);
+        return 1;
+    }
+    WriteJson(out, spec, results);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -19,21 +19,25 @@ if %ERRORLEVEL% NEQ 0 (
     exit /b 1
 )
 
-echo [1/4] Cleaning previous build...
+echo [1/5] Cleaning previous build...
 if exist EduSavant.exe del EduSavant.exe
+if exist EduSavant-cli.exe del EduSavant-cli.exe
 if exist *.o del *.o
 if exist src\*.o del src\*.o
 if exist vendor\imgui\*.o del vendor\imgui\*.o
 if exist vendor\imgui\backends\*.o del vendor\imgui\backends\*.o
 
-echo [2/4] Compiling source files...
+echo [2/5] Compiling source files...
 g++ -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -c -o main.o main.cpp
 if %ERRORLEVEL% NEQ 0 goto :error
 
 g++ -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -c -o src\App.o src\App.cpp
 if %ERRORLEVEL% NEQ 0 goto :error
 
-echo [3/4] Compiling ImGui library...
+g++ -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -c -o src\AppWindow.o src\AppWindow.cpp
+if %ERRORLEVEL% NEQ 0 goto :error
+
+echo [3/5] Compiling ImGui library...
 g++ -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -c -o vendor\imgui\imgui.o vendor\imgui\imgui.cpp
 if %ERRORLEVEL% NEQ 0 goto :error
 
@@ -55,8 +59,12 @@ if %ERRORLEVEL% NEQ 0 goto :error
 g++ -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -c -o vendor\imgui\backends\imgui_impl_opengl3.o vendor\imgui\backends\imgui_impl_opengl3.cpp
 if %ERRORLEVEL% NEQ 0 goto :error
 
-echo [4/4] Linking executable...
-g++ -o EduSavant.exe main.o src\App.o vendor\imgui\imgui.o vendor\imgui\imgui_demo.o vendor\imgui\imgui_draw.o vendor\imgui\imgui_tables.o vendor\imgui\imgui_widgets.o vendor\imgui\backends\imgui_impl_glfw.o vendor\imgui\backends\imgui_impl_opengl3.o -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -lopengl32 -lgdi32 -lglfw3 -mwindows
+echo [4/5] Linking executable...
+g++ -o EduSavant.exe main.o src\App.o src\AppWindow.o vendor\imgui\imgui.o vendor\imgui\imgui_demo.o vendor\imgui\imgui_draw.o vendor\imgui\imgui_tables.o vendor\imgui\imgui_widgets.o vendor\imgui\backends\imgui_impl_glfw.o vendor\imgui\backends\imgui_impl_opengl3.o -I. -I.\src -I.\vendor\imgui -I.\vendor\imgui\backends -g -Wall -Wformat -lopengl32 -lgdi32 -lglfw3 -mwindows
+if %ERRORLEVEL% NEQ 0 goto :error
+
+echo [5/5] Building command-line tool...
+g++ -I. -I.\src -g -Wall -Wformat -o EduSavant-cli.exe cli_main.cpp
 if %ERRORLEVEL% NEQ 0 goto :error
 
 echo.
@@ -64,6 +72,7 @@ echo ========================================
 echo BUILD SUCCESSFUL!
 echo ========================================
 echo Executable created: EduSavant.exe
+echo Command-line tool created: EduSavant-cli.exe
 echo.
 echo To run the application, double-click EduSavant.exe
 echo or run: EduSavant.exe
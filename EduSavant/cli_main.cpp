@@ -0,0 +1,6 @@
+#include "src/Cli.h"
+
+// EduSavant-cli: batch mode without a window, linked without GLFW or OpenGL.
+int main(int argc, char** argv) {
+    return Cli::Run(argv[0], argc - 1, argv + 1);
+}
@@ -1,6 +1,48 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
 #include "src/App.h"
+#include "src/Cli.h"
 
-int main(int, char**) {
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+// Feeds the profiler's allocation counters; a relaxed load while it is off.
+void* operator new(size_t size) {
+    Profiler::CountAllocation(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+// Out of line so GCC does not pair the inlined free() with operator new and warn
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// EduSavant.exe is linked with -mwindows, so it starts without a console
+// and --batch output would go nowhere. Borrow the console it was run from,
+// unless the output has been redirected to a file or pipe.
+static void AttachParentConsole() {
+#ifdef _WIN32
+    bool outRedirected = GetFileType(GetStdHandle(STD_OUTPUT_HANDLE)) != FILE_TYPE_UNKNOWN;
+    bool errRedirected = GetFileType(GetStdHandle(STD_ERROR_HANDLE)) != FILE_TYPE_UNKNOWN;
+    if (!AttachConsole(ATTACH_PARENT_PROCESS)) return;
+    if (!outRedirected) std::freopen("CONOUT$", "w", stdout);
+    if (!errRedirected) std::freopen("CONOUT$", "w", stderr);
+#endif
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--batch") == 0) {
+        AttachParentConsole();
+        return Cli::Run("EduSavant --batch", argc - 2, argv + 2);
+    }
     App app;
     app.Run();
     return 0;
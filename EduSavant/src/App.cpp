@@ -1,147 +1,65 @@
 #include "App.h"
 #include "UI/Theme.h"
 #include "imgui_internal.h"
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 
-static void glfw_error_callback(int error, const char* description) {
-    fprintf(stderr, "GLFW Error %d: %s\n", error, description);
+bool App::Busy() const {
+    return (studentImport && !studentImport->Finished()) || dataManager.ImportPending() ||
+           (exportProgress && !exportProgress->finished) || profilerOverlay.Saving() || dataManager.AnalyticsPending();
 }
 
-App::App() {
-    Init();
-}
-
-App::~App() {
-    Shutdown();
-}
+void App::RenderFrame() {
+    // Create main DockSpace
+    ImGuiID dockspace_id = ImGui::GetID("MyDockSpace");
+    ImGui::DockSpaceOverViewport(dockspace_id, ImGui::GetMainViewport());
 
-void App::Init() {
-    glfwSetErrorCallback(glfw_error_callback);
-    
-    printf("--- EduSavant (Debug Build) ---\n");
-    printf("DISPLAY: %s\n", getenv("DISPLAY"));
-    printf("Setting GLFW_PLATFORM = x11\n");
-    
-    // Force X11 backend using environment variable
-    setenv("GLFW_PLATFORM", "x11", 1);
+    static bool first_time = true;
+    if (first_time)
+    {
+        first_time = false;
+        
+        ImGui::DockBuilderRemoveNode(dockspace_id); // Clear out existing layout
+        ImGui::DockBuilderAddNode(dockspace_id, ImGuiDockNodeFlags_DockSpace); // Add empty node
+        ImGui::DockBuilderSetNodeSize(dockspace_id, ImGui::GetMainViewport()->Size);
 
-    if (!glfwInit()) {
-        fprintf(stderr, "Failed to initialize GLFW. Ensure X11/Wayland is correctly configured.\n");
-        std::exit(1);
+        ImGuiID dock_main_id = dockspace_id;
+        ImGuiID dock_id_left = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Left, 0.20f, NULL, &dock_main_id);
+        
+        ImGui::DockBuilderDockWindow("Navigation", dock_id_left);
+        ImGui::DockBuilderDockWindow("Dashboard", dock_main_id);
+        ImGui::DockBuilderDockWindow("Student Management", dock_main_id);
+        ImGui::DockBuilderDockWindow("Staff Management", dock_main_id);
+        ImGui::DockBuilderDockWindow("Settings", dock_main_id);
+        
+        ImGui::DockBuilderFinish(dockspace_id);
     }
 
-    // GL 3.0 + GLSL 130
-    glsl_version = "#version 130";
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
-
-    window = glfwCreateWindow(1280, 800, "EduSavant - School Management System", nullptr, nullptr);
-    if (window == nullptr)
-        std::exit(1);
-
-    glfwMakeContextCurrent(window);
-    glfwSwapInterval(1); // Enable vsync
-
-    // Setup Dear ImGui context
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO& io = ImGui::GetIO(); (void)io;
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;     
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
-    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
-    io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
-
-    // Setup Dear ImGui style
-    Theme::Setup();
+    RenderSidebar();
     
-    // When viewports are enabled we tweak WindowRounding/WindowBg so platform windows can look identical to regular ones.
-    ImGuiStyle& style = ImGui::GetStyle();
-    if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
-    {
-        style.WindowRounding = 0.0f;
-        style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+    switch (currentScreen) {
+        case Screen::Dashboard: RenderDashboard(); break;
+        case Screen::Students:  RenderStudentList(); break;
+        case Screen::Teachers:  RenderStaffList(); break; // Still using "Teachers" enum screen, but rendering Staff
+        case Screen::Settings:  RenderSettings(); break;
     }
 
-    // Setup Platform/Renderer backends
-    ImGui_ImplGlfw_InitForOpenGL(window, true);
-    ImGui_ImplOpenGL3_Init(glsl_version);
-}
-
-void App::Run() {
-    ImGuiIO& io = ImGui::GetIO();
-    ImVec4 clear_color = ImVec4(0.11f, 0.15f, 0.17f, 1.00f);
-
-    while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
-
-        // Start the Dear ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        // Create main DockSpace
-        ImGuiID dockspace_id = ImGui::GetID("MyDockSpace");
-        ImGui::DockSpaceOverViewport(dockspace_id, ImGui::GetMainViewport());
+    if(showAddStudentModal) ShowAddStudentModal();
+    if(showAddTeacherModal) ShowAddStaffModal(); // Using boolean to trigger Staff modal
+    if(showImportModal) ShowImportModal();
+    if(showExportModal) ShowExportModal();
+    confirmDialog.Render();
 
-        static bool first_time = true;
-        if (first_time)
-        {
-            first_time = false;
-            
-            ImGui::DockBuilderRemoveNode(dockspace_id); // Clear out existing layout
-            ImGui::DockBuilderAddNode(dockspace_id, ImGuiDockNodeFlags_DockSpace); // Add empty node
-            ImGui::DockBuilderSetNodeSize(dockspace_id, ImGui::GetMainViewport()->Size);
-
-            ImGuiID dock_main_id = dockspace_id;
-            ImGuiID dock_id_left = ImGui::DockBuilderSplitNode(dock_main_id, ImGuiDir_Left, 0.20f, NULL, &dock_main_id);
-            
-            ImGui::DockBuilderDockWindow("Navigation", dock_id_left);
-            ImGui::DockBuilderDockWindow("Dashboard", dock_main_id);
-            ImGui::DockBuilderDockWindow("Student Management", dock_main_id);
-            ImGui::DockBuilderDockWindow("Staff Management", dock_main_id);
-            ImGui::DockBuilderDockWindow("Settings", dock_main_id);
-            
-            ImGui::DockBuilderFinish(dockspace_id);
-        }
-
-        RenderSidebar();
-        
-        switch (currentScreen) {
-            case Screen::Dashboard: RenderDashboard(); break;
-            case Screen::Students:  RenderStudentList(); break;
-            case Screen::Teachers:  RenderStaffList(); break; // Still using "Teachers" enum screen, but rendering Staff
-            case Screen::Settings:  RenderSettings(); break;
-        }
-
-        if(showAddStudentModal) ShowAddStudentModal();
-        if(showAddTeacherModal) ShowAddStaffModal(); // Using boolean to trigger Staff modal
-
-        // Rendering
-        ImGui::Render();
-        int display_w, display_h;
-        glfwGetFramebufferSize(window, &display_w, &display_h);
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        
-        // Update and Render additional Platform Windows
-        if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
-        {
-            GLFWwindow* backup_current_context = glfwGetCurrentContext();
-            ImGui::UpdatePlatformWindows();
-            ImGui::RenderPlatformWindowsDefault();
-            glfwMakeContextCurrent(backup_current_context);
-        }
+    if (ImGui::IsKeyPressed(ImGuiKey_F12, false)) profilerOverlay.open = !profilerOverlay.open;
+    profilerOverlay.Render();
 
-        glfwSwapBuffers(window);
-    }
+    // Hand this frame's saves to the persistence thread (never blocks)
+    dataManager.Pump();
 }
 
-
-
 void App::RenderSidebar() {
+    PROFILE_SCOPE("RenderSidebar");
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
     ImGui::Begin("Navigation", nullptr, window_flags);
     
@@ -175,10 +93,30 @@ void App::RenderSidebar() {
         ImGui::SetWindowFocus("Settings"); 
     }
 
+    // Save status
+    ImGui::Spacing();
+    ImGui::Separator();
+    if (dataManager.StudentsUnreadable())
+        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "students.db could not be read; student changes are not saved.");
+    switch (dataManager.GetSaveStatus()) {
+        case Storage::PersistenceService::Status::Saving:
+            ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.2f, 1.0f), "Saving...");
+            break;
+        case Storage::PersistenceService::Status::Saved:
+            ImGui::TextDisabled("All changes saved (%.0fs ago)", dataManager.SecondsSinceLastSave());
+            break;
+        case Storage::PersistenceService::Status::Failed:
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Save failed! Check disk space.");
+            break;
+        case Storage::PersistenceService::Status::Idle:
+            break;
+    }
+
     ImGui::End();
 }
 
 void App::RenderDashboard() {
+    PROFILE_SCOPE("RenderDashboard");
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
     ImGui::Begin("Dashboard", nullptr, window_flags);
     
@@ -203,22 +141,182 @@ void App::RenderDashboard() {
     ImGui::EndGroup();
     ImGui::NextColumn();
 
+    // Everything below reads maintained aggregates; nothing here scans the roster
+    const RosterStats& stats = dataManager.Stats();
     ImGui::BeginGroup();
     ImGui::Text("Average Attendance");
-    float totalAttendance = 0.0f;
-    for(const auto& s : dataManager.students) totalAttendance += s.getAttendance();
-    float avg = dataManager.students.empty() ? 0.0f : totalAttendance / dataManager.students.size();
-    ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.2f, 1.0f), "%.1f%%", avg);
+    ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.2f, 1.0f), "%.1f%%", stats.MeanAttendance());
+    ImGui::TextDisabled("Min %.1f%%  Max %.1f%%", stats.MinAttendance(), stats.MaxAttendance());
     ImGui::EndGroup();
     
     ImGui::Columns(1);
     ImGui::Spacing();
     ImGui::Separator();
 
+    // Per class-section breakdown, in the order of the class configuration
+    if (ImGui::BeginTable("dashboard_sections", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("Class");
+        ImGui::TableSetupColumn("Section");
+        ImGui::TableSetupColumn("Students");
+        ImGui::TableSetupColumn("Avg Attendance");
+        ImGui::TableHeadersRow();
+        const ClassConfig& config = ClassConfig::Get();
+        for (ClassId cls : config.Classes()) {
+            const ClassConfig::ClassEntry& c = config.Class(cls);
+            for (SectionId sec : config.Sections(cls)) {
+                const ClassConfig::SectionEntry& section = config.Section(sec);
+                RosterStats::Group g = stats.Section(c.symbol, section.symbol);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s", c.name.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%s", section.name.c_str());
+                ImGui::TableNextColumn(); ImGui::Text("%u", g.count);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f%%", g.MeanAttendance());
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    // Mean mark per subject and term, kept by RosterStats in name order
+    const std::vector<RosterStats::SubjectRow>& subjectMeans = stats.Subjects();
+    bool anyMarks = std::any_of(subjectMeans.begin(), subjectMeans.end(),
+                                [](const RosterStats::SubjectRow& row) { return !row.Empty(); });
+    if (anyMarks) {
+        static const char* const kTermLabels[] = { "Term 1", "Term 2", "Term 3", "Term 4" };
+        static_assert(std::size(kTermLabels) == MarkSheet::kTerms, "One label per term");
+        ImGui::Spacing();
+        if (ImGui::BeginTable("dashboard_subjects", 1 + MarkSheet::kTerms, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("Subject");
+            for (const char* label : kTermLabels) ImGui::TableSetupColumn(label);
+            ImGui::TableHeadersRow();
+            for (const RosterStats::SubjectRow& row : subjectMeans) {
+                if (row.Empty()) continue;
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(SymbolTable::Get().Str(row.subject).c_str());
+                for (const RosterStats::Score& score : row.terms) {
+                    ImGui::TableNextColumn();
+                    if (score.count) ImGui::Text("%.1f", score.Mean());
+                    else ImGui::TextDisabled("-");
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    ImGui::Spacing();
+    RenderAnalytics();
+
     ImGui::End();
 }
 
+void App::RenderAnalytics() {
+    ImGui::SetNextItemOpen(analyticsOpen);
+    bool open = ImGui::CollapsingHeader("Academic Analytics");
+    if (ImGui::IsItemToggledOpen()) analyticsOpen = open; // Not on frames the window skips
+    if (!open) return; // Nothing is computed while the panel is closed
+    PROFILE_SCOPE("RenderAnalytics");
+    const MarkReport& report = dataManager.Analytics();
+
+    ImGui::SetNextItemWidth(150);
+    analyticsScope.ClassCombo("Class##Analytics");
+    ImGui::SameLine();
+    ImGui::BeginDisabled(analyticsScope.Class() == kNoClass);
+    ImGui::SetNextItemWidth(100);
+    analyticsScope.SectionCombo("Section##Analytics");
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    ImGui::Combo("Term##Analytics", &analyticsTerm, "Term 1\0Term 2\0Term 3\0Term 4\0");
+    ImGui::SameLine();
+    if (!dataManager.AnalyticsReady()) {
+        ImGui::TextDisabled("Computing...");
+        return;
+    }
+    // The previous report stays up while the background thread catches up
+    ImGui::TextDisabled(dataManager.AnalyticsPending() ? "Computed in %.1f ms, updating..." : "Computed in %.1f ms",
+                        report.seconds * 1000.0);
+
+    const MarkReport::Group* group = report.Find(analyticsScope.ClassSymbol(), analyticsScope.SectionSymbol());
+    if (!group || group->subjects[analyticsTerm].empty()) {
+        ImGui::TextDisabled("No subjects configured.");
+        return;
+    }
+
+    // One row per subject; percentiles are marks, grades a histogram A+ .. NG
+    const std::vector<MarkReport::SubjectStats>& subjects = group->subjects[analyticsTerm];
+    if (ImGui::BeginTable("analytics_subjects", 11, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        static const char* const kColumns[] = { "Subject", "Marked", "Mean", "Std Dev", "Min", "P25", "Median", "P75", "P90", "Max" };
+        for (const char* name : kColumns) ImGui::TableSetupColumn(name);
+        ImGui::TableSetupColumn("Grades (A+ .. NG)", ImGuiTableColumnFlags_WidthFixed, 170.0f);
+        ImGui::TableHeadersRow();
+        for (size_t row = 0; row < subjects.size(); ++row) {
+            const MarkReport::SubjectStats& s = subjects[row];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(SymbolTable::Get().Str(s.subject).c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%u / %u", s.count, group->students);
+            if (s.count == 0) {
+                for (int column = 2; column < 11; ++column) { ImGui::TableNextColumn(); ImGui::TextDisabled("-"); }
+                continue;
+            }
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.mean);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", s.stddev);
+            for (int mark : { s.min, s.p25, s.median, s.p75, s.p90, s.max }) {
+                ImGui::TableNextColumn(); ImGui::Text("%d", mark);
+            }
+            ImGui::TableNextColumn();
+            ImGui::PushID(static_cast<int>(row));
+            ImGui::PlotHistogram("##grades", [](void* data, int g) {
+                return float(static_cast<const MarkReport::SubjectStats*>(data)->grades[g]);
+            }, const_cast<MarkReport::SubjectStats*>(&s), MarkReport::kGrades, 0, nullptr, 0.0f, FLT_MAX,
+                ImVec2(-FLT_MIN, ImGui::GetTextLineHeight()));
+            if (ImGui::IsItemHovered()) {
+                ImGui::BeginTooltip();
+                for (int g = 0; g < MarkReport::kGrades; ++g)
+                    ImGui::Text("%-2s (%d+)  %u", MarkReport::kGradeBands[g].name, MarkReport::kGradeBands[g].minMark, s.grades[g]);
+                ImGui::EndTooltip();
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+
+    // A section also ranks its students by term average
+    if (group->section == kNoSymbol) return;
+    const std::vector<MarkReport::RankedStudent>& ranking = group->ranking[analyticsTerm];
+    ImGui::Spacing();
+    ImGui::Text("Ranking: %zu of %u students have marks this term", ranking.size(), group->students);
+    if (ranking.empty()) return;
+    float height = std::min(ImGui::GetTextLineHeightWithSpacing() * (ranking.size() + 1.5f), 300.0f);
+    if (ImGui::BeginTable("analytics_ranking", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                          ImVec2(0.0f, height))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Rank", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableSetupColumn("Roll", ImGuiTableColumnFlags_WidthFixed, 50.0f);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Average", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        ImGui::TableSetupColumn("Percentile", ImGuiTableColumnFlags_WidthFixed, 100.0f);
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(ranking.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const MarkReport::RankedStudent& r = ranking[i];
+                std::optional<StudentTable::Row> s = dataManager.FindStudent(r.id); // Gone if deleted since
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%u", r.rank);
+                ImGui::TableNextColumn();
+                if (s) ImGui::Text("%d", s->getRollNumber());
+                else ImGui::TextDisabled("-");
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(s ? s->getName().c_str() : "(deleted)");
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", r.average);
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(MarkReport::PercentileBand(r.rank, ranking.size()));
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
 void App::RenderStaffList() {
+    PROFILE_SCOPE("RenderStaffList");
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
     ImGui::Begin("Staff Management", nullptr, window_flags);
 
@@ -234,10 +332,16 @@ void App::RenderStaffList() {
         memset(inputStaffSubject, 0, sizeof(inputStaffSubject));
         strcpy(inputStaffRole, "Teacher");
     }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Export", ImVec2(120, 40))) {
+        if (!exportProgress) exportDataset = int(Storage::ExportDataset::Staff);
+        showExportModal = true;
+    }
     
     ImGui::SameLine();
-    static char searchBuffer[128] = "";
-    ImGui::InputTextWithHint("##searchStaff", "Search by name...", searchBuffer, sizeof(searchBuffer));
+    ImGui::InputTextWithHint("##searchStaff", "Search name, email, phone...", staffSearch, sizeof(staffSearch));
+    RefreshStaffView();
 
     ImGui::Spacing();
 
@@ -262,49 +366,40 @@ void App::RenderStaffList() {
             ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_WidthFixed, 80.0f);
             ImGui::TableHeadersRow();
 
-            for (auto& s : dataManager.staffMembers) {
-                if (strlen(searchBuffer) > 0 && s.getName().find(searchBuffer) == std::string::npos)
-                    continue;
+            // Only the visible rows are submitted
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(staffView.rows.size()));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    const Staff& s = dataManager.staffMembers[staffView.rows[row]];
 
-                ImGui::TableNextRow();
-                ImGui::TableNextColumn();
-                ImGui::Text("%d", s.getId());
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d", s.getId());
                 
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", s.getName().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", s.getName().c_str());
 
-                ImGui::TableNextColumn();
-                ImGui::TextColored(ImVec4(0.3f, 0.8f, 0.9f, 1.0f), "%s", s.getRole().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::TextColored(ImVec4(0.3f, 0.8f, 0.9f, 1.0f), "%s", s.getRole().c_str());
 
-                ImGui::TableNextColumn();
-                if (s.getRole() == "Teacher") {
-                    ImGui::Text("Sub: %s", s.getSubject().c_str());
-                } else {
-                     ImGui::Text("Ph: %s", s.getPhone().c_str());
-                }
+                    ImGui::TableNextColumn();
+                    static const Symbol teacherRole = SymbolTable::Get().Intern("Teacher");
+                    if (s.getRoleSymbol() == teacherRole) {
+                        ImGui::Text("Sub: %s", s.getSubject().c_str());
+                    } else {
+                         ImGui::Text("Ph: %s", s.getPhone().c_str());
+                    }
 
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", s.getEmail().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", s.getEmail().c_str());
 
-                ImGui::TableNextColumn();
-                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
-                if (ImGui::Button(("Del##S" + std::to_string(s.getId())).c_str())) {
-                    ImGui::OpenPopup(("DeleteStaff?" + std::to_string(s.getId())).c_str());
-                }
-                ImGui::PopStyleColor();
-
-                if (ImGui::BeginPopupModal(("DeleteStaff?" + std::to_string(s.getId())).c_str(), NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
-                    ImGui::Text("Delete staff %s?", s.getName().c_str());
-                    ImGui::Separator();
-                    if (ImGui::Button("Yes", ImVec2(100,0))) {
-                        dataManager.DeleteStaff(s.getId());
-                        ImGui::CloseCurrentPopup();
-                    }
-                    ImGui::SameLine();
-                    if (ImGui::Button("Cancel", ImVec2(100,0))) {
-                        ImGui::CloseCurrentPopup();
-                    }
-                    ImGui::EndPopup();
+                    ImGui::TableNextColumn();
+                    ImGui::PushID(s.getId());
+                    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
+                    if (ImGui::Button("Del")) AskDeleteStaff(s.getId());
+                    ImGui::PopStyleColor();
+                    ImGui::PopID();
                 }
             }
             ImGui::EndTable();
@@ -315,7 +410,29 @@ void App::RenderStaffList() {
     ImGui::End();
 }
 
+void App::RefreshStaffView() {
+    if (staffView.dataVersion == dataManager.StaffVersion() && staffView.search == staffSearch)
+        return;
+    PROFILE_SCOPE("RefreshStaffView"); // Only rebuilds are timed
+    staffView.dataVersion = dataManager.StaffVersion();
+    staffView.search = staffSearch;
+
+    // A search lists matches best first, straight from the search index
+    if (!staffView.search.empty()) {
+        staffView.rows = dataManager.SearchStaff(staffView.search);
+        return;
+    }
+
+    staffView.rows.clear();
+    const auto& staff = dataManager.staffMembers;
+    for (int i = 0; i < static_cast<int>(staff.size()); ++i) staffView.rows.push_back(i);
+    // Deletes swap slots around; list in ID (= joining) order
+    std::sort(staffView.rows.begin(), staffView.rows.end(),
+              [&staff](int a, int b) { return staff[a].getId() < staff[b].getId(); });
+}
+
 void App::RenderSettings() {
+    PROFILE_SCOPE("RenderSettings");
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
     ImGui::Begin("Settings", nullptr, window_flags);
     
@@ -335,6 +452,15 @@ void App::RenderSettings() {
     ImGui::Separator();
     ImGui::Spacing();
 
+    // RENDERING
+    ImGui::TextDisabled("PERFORMANCE");
+    ImGui::Checkbox("Power saving (redraw only on input)", &frameSettings.powerSaving);
+    ImGui::Checkbox("Show profiler (F12)", &profilerOverlay.open);
+    ImGui::SliderInt("Frame rate cap", &frameSettings.maxFps, 0, 240, frameSettings.maxFps == 0 ? "Off (vsync)" : "%d fps");
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
     // ACADEMIC CONFIGURATION
     ImGui::TextDisabled("ACADEMIC CONFIGURATION");
     
@@ -352,26 +478,10 @@ void App::RenderSettings() {
     ImGui::Spacing();
     
     // Select Class to Configure
-    auto& mapClasses = ClassConfig::Get().classesAndSections;
-    std::vector<std::string> classNames;
-    for(auto const& [name, _] : mapClasses) classNames.push_back(name);
-    
-    if (!classNames.empty()) {
-        if (selectedClassConfigIndex >= classNames.size()) selectedClassConfigIndex = 0;
-        
-        // Create a C-string array for Combo
-        // This is a bit hacky in immediate mode, loops are better for custom combos
-        if (ImGui::BeginCombo("Select Class", classNames[selectedClassConfigIndex].c_str())) {
-            for (int n = 0; n < classNames.size(); n++) {
-                bool is_selected = (selectedClassConfigIndex == n);
-                if (ImGui::Selectable(classNames[n].c_str(), is_selected))
-                    selectedClassConfigIndex = n;
-                if (is_selected) ImGui::SetItemDefaultFocus();
-            }
-            ImGui::EndCombo();
-        }
-
-        std::string currentClass = classNames[selectedClassConfigIndex];
+    const ClassConfig& config = ClassConfig::Get();
+    if (!config.Classes().empty()) {
+        configClass.ClassCombo("Select Class");
+        const std::string& currentClass = config.Class(configClass.Class()).name;
 
         ImGui::Columns(2, "config_cols", false);
         
@@ -388,9 +498,8 @@ void App::RenderSettings() {
             }
         }
         ImGui::TextDisabled("Current Sections:");
-        auto sections = ClassConfig::Get().GetSections(currentClass);
-        for(const auto& sec : sections) {
-            ImGui::BulletText("%s", sec.c_str());
+        for (SectionId sec : config.Sections(configClass.Class())) {
+            ImGui::BulletText("%s", config.Section(sec).name.c_str());
         }
         ImGui::EndGroup();
 
@@ -398,27 +507,15 @@ void App::RenderSettings() {
 
         // Subjects Column (Now Dependent on Section)
         ImGui::BeginGroup();
-        if (sections.empty()) {
+        if (configClass.Section() == kNoSection) {
              ImGui::TextColored(ImVec4(1,0,0,1), "Add a Section first!");
         } else {
-             // Section Selector for Subjects
-             static int selectedSectionIdx = 0;
-             if (selectedSectionIdx >= sections.size()) selectedSectionIdx = 0;
-             
-             std::string currentSection = sections[selectedSectionIdx];
+             const std::string& currentSection = config.Section(configClass.Section()).name;
 
              ImGui::Text("Subjects for %s-%s", currentClass.c_str(), currentSection.c_str());
              
              // Simple combo to switch section focus
-             if (ImGui::BeginCombo("Select Section##Subj", currentSection.c_str())) {
-                for (int n = 0; n < sections.size(); n++) {
-                    bool is_selected = (selectedSectionIdx == n);
-                    if (ImGui::Selectable(sections[n].c_str(), is_selected))
-                        selectedSectionIdx = n;
-                    if (is_selected) ImGui::SetItemDefaultFocus();
-                }
-                ImGui::EndCombo();
-            }
+             configClass.SectionCombo("Select Section##Subj");
 
              ImGui::InputTextWithHint("##newsubj", "New Subject", inputNewSubjectName, sizeof(inputNewSubjectName));
              ImGui::SameLine();
@@ -430,8 +527,8 @@ void App::RenderSettings() {
                 }
             }
             ImGui::TextDisabled("Current Subjects:");
-            for(const auto& sub : ClassConfig::Get().GetSubjects(currentClass, currentSection)) {
-                ImGui::BulletText("%s", sub.c_str());
+            for (Symbol sub : config.Subjects(configClass.Section())) {
+                ImGui::BulletText("%s", SymbolTable::Get().Str(sub).c_str());
             }
         }
        
@@ -446,6 +543,20 @@ void App::RenderSettings() {
     ImGui::Separator();
     ImGui::Spacing();
     
+    // End of year
+    ImGui::TextDisabled("END OF YEAR");
+    ImGui::TextWrapped("Moves every class up one, keeping section names where the next class has them, "
+                       "and archives the final class instead of deleting it.");
+    ImGui::SetNextItemWidth(150);
+    ImGui::InputTextWithHint("Archive label", "current year", promotionLabel, sizeof(promotionLabel));
+    ImGui::Checkbox("Clear marks and attendance of promoted students", &promotionResetMarks);
+    if (ImGui::Button("Promote Classes...", ImVec2(200, 40))) AskPromotion();
+    if (!promotionMessage.empty()) ImGui::TextWrapped("%s", promotionMessage.c_str());
+
+    ImGui::Spacing();
+    ImGui::Separator();
+    ImGui::Spacing();
+
     // Data Management
     ImGui::TextDisabled("DATA MANAGEMENT");
     if (ImGui::Button("Reset All Data", ImVec2(200, 45))) {
@@ -458,10 +569,7 @@ void App::RenderSettings() {
         ImGui::Separator();
 
         if (ImGui::Button("Yes, Delete All", ImVec2(120, 0))) {
-            dataManager.students.clear();
-            dataManager.staffMembers.clear();
-            dataManager.SaveStudents();
-            dataManager.SaveStaff();
+            dataManager.ClearAll();
             ImGui::CloseCurrentPopup();
         }
         ImGui::SetItemDefaultFocus();
@@ -487,6 +595,7 @@ void App::RenderSettings() {
 }
 
 void App::ShowAddStaffModal() {
+    PROFILE_SCOPE("ShowAddStaffModal");
     ImGui::OpenPopup("Add Staff");
     ImVec2 center = ImGui::GetMainViewport()->GetCenter();
     ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
@@ -512,9 +621,7 @@ void App::ShowAddStaffModal() {
         ImGui::Spacing();
 
         if (ImGui::Button("Save", ImVec2(120, 0))) {
-            int maxId = 0;
-            for(const auto& s : dataManager.staffMembers) if(s.getId() > maxId) maxId = s.getId();
-            int newId = maxId + 1;
+            int newId = dataManager.getNextStaffId();
             
             // Should sanitize role from combo
             std::string roleStr = roles[current_role_idx];
@@ -530,21 +637,15 @@ void App::ShowAddStaffModal() {
 
 
 // Helper to get subjects for student's class
-const std::vector<std::string> GetSubjectsForStudent(const Student& s) {
-    return ClassConfig::Get().GetSubjects(s.getClassName(), s.getSection());
+Span<Symbol> GetSubjectsForStudent(const StudentTable::ConstRow& s) {
+    return ClassConfig::Get().SubjectsOf(s.getClassSymbol(), s.getSectionSymbol());
 }
 
 void App::ShowStudentProfileModal() {
+    PROFILE_SCOPE("ShowStudentProfileModal");
     if (selectedStudentId == -1) return;
 
-    // Find student pointer
-    Student* currentStudent = nullptr;
-    for(auto& s : dataManager.students) {
-        if(s.getId() == selectedStudentId) {
-            currentStudent = &s;
-            break;
-        }
-    }
+    std::optional<StudentTable::Row> currentStudent = dataManager.FindStudent(selectedStudentId);
     
     if(!currentStudent) {
         selectedStudentId = -1; // Invalid
@@ -580,6 +681,7 @@ void App::ShowStudentProfileModal() {
                 static char editFather[128];
                 static char editPhone[128];
                 static char editEmail[128];
+                static float editAttendance;
                 
                 // Initialize buffers (only once per open ideally, but here doing per frame if changed? 
                 // Better: init when modal opens. For now, simple direct copy)
@@ -588,6 +690,7 @@ void App::ShowStudentProfileModal() {
                     strcpy(editFather, currentStudent->getFatherName().c_str());
                     strcpy(editPhone, currentStudent->getPhone().c_str());
                     strcpy(editEmail, currentStudent->getEmail().c_str());
+                    editAttendance = currentStudent->getAttendance();
                 }
 
                 ImGui::Columns(2, "profile_info", false);
@@ -595,27 +698,33 @@ void App::ShowStudentProfileModal() {
                 ImGui::Text("Section:"); ImGui::NextColumn(); ImGui::Text("%s", currentStudent->getSection().c_str()); ImGui::NextColumn();
                 
                 ImGui::Text("Name:"); ImGui::NextColumn(); 
-                if(ImGui::InputText("##name", editName, sizeof(editName))) currentStudent->setName(editName);
+                ImGui::InputText("##name", editName, sizeof(editName));
                 ImGui::NextColumn();
 
                 ImGui::Text("Father's Name:"); ImGui::NextColumn(); 
-                if(ImGui::InputText("##father", editFather, sizeof(editFather))) currentStudent->setFatherName(editFather);
+                ImGui::InputText("##father", editFather, sizeof(editFather));
                 ImGui::NextColumn();
                 
                 ImGui::Text("Contact:"); ImGui::NextColumn(); 
-                if(ImGui::InputText("##phone", editPhone, sizeof(editPhone))) currentStudent->setPhone(editPhone);
+                ImGui::InputText("##phone", editPhone, sizeof(editPhone));
                 ImGui::NextColumn();
                
                 ImGui::Text("Email:"); ImGui::NextColumn(); 
-                if(ImGui::InputText("##email", editEmail, sizeof(editEmail))) currentStudent->setEmail(editEmail);
+                ImGui::InputText("##email", editEmail, sizeof(editEmail));
+                ImGui::NextColumn();
+
+                ImGui::Text("Attendance (%%):"); ImGui::NextColumn();
+                ImGui::SliderFloat("##attendance", &editAttendance, 0.0f, 100.0f, "%.1f");
                 ImGui::NextColumn();
                 
                 ImGui::Columns(1);
                 
                 ImGui::Spacing();
                 if (ImGui::Button("Save Details")) {
-                    dataManager.RecalculateRollNumbers(); // Name change affects roll no
-                    dataManager.SaveStudents();
+                    // Edits stay in the buffers until saved; the update is journaled
+                    dataManager.UpdateStudentDetails(selectedStudentId, editName, editFather, editPhone, editEmail);
+                    dataManager.SetStudentAttendance(selectedStudentId, editAttendance);
+                    dataManager.SyncJournal();
                 }
                 
                 ImGui::EndTabItem();
@@ -627,7 +736,7 @@ void App::ShowStudentProfileModal() {
                 if (ImGui::BeginTabItem(tabName.c_str())) {
                     ImGui::Spacing();
                     
-                    std::vector<std::string> subjects = GetSubjectsForStudent(*currentStudent);
+                    Span<Symbol> subjects = GetSubjectsForStudent(*currentStudent);
                     if (subjects.empty()) {
                         ImGui::TextColored(ImVec4(1, 1, 0, 1), "No subjects configured for Class %s", currentStudent->getClassName().c_str());
                     } else {
@@ -636,26 +745,27 @@ void App::ShowStudentProfileModal() {
                         ImGui::TableSetupColumn("Marks (Out of 100)");
                         ImGui::TableHeadersRow();
 
-                        for (const auto& sub : subjects) {
+                        for (size_t slot = 0; slot < subjects.size(); ++slot) {
+                            Symbol subSymbol = subjects[slot];
+                            const std::string& sub = SymbolTable::Get().Str(subSymbol);
                             ImGui::TableNextRow();
                             ImGui::TableNextColumn();
                             ImGui::Text("%s", sub.c_str());
                             
                             ImGui::TableNextColumn();
-                            int currentMark = currentStudent->getMark(term, sub);
-                            int startMark = currentMark; // For change detection
+                            int currentMark = currentStudent->getMark(term, subSymbol, slot);
                             
                             std::string id = "##" + std::to_string(term) + sub;
                             if (ImGui::InputInt(id.c_str(), &currentMark, 0, 0)) {
                                 if (currentMark < 0) currentMark = 0;
                                 if (currentMark > 100) currentMark = 100;
-                                currentStudent->setMark(term, sub, currentMark);
+                                dataManager.SetStudentMark(selectedStudentId, term, subSymbol, currentMark);
                             }
                         }
                         ImGui::EndTable();
                         
                         if (ImGui::Button("Save Marks")) {
-                            dataManager.SaveStudents();
+                            dataManager.SyncJournal(); // Marks are journaled as they are typed
                         }
                     }
                     ImGui::EndTabItem();
@@ -675,6 +785,7 @@ void App::ShowStudentProfileModal() {
 }
 
 void App::RenderStudentList() {
+    PROFILE_SCOPE("RenderStudentList");
     ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove;
     ImGui::Begin("Student Management", nullptr, window_flags);
 
@@ -686,14 +797,22 @@ void App::RenderStudentList() {
         memset(inputName, 0, sizeof(inputName));
         memset(inputEmail, 0, sizeof(inputEmail));
         memset(inputPhone, 0, sizeof(inputPhone));
-        inputClassIndex = 0;
-        inputSectionIndex = 0;
+        inputClass.Reset();
         memset(inputFatherName, 0, sizeof(inputFatherName));
     }
+
+    ImGui::SameLine();
+    if (ImGui::Button(studentImport || dataManager.ImportPending() ? "Import (running)" : "Import CSV", ImVec2(200, 40))) {
+        showImportModal = true;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Export", ImVec2(120, 40))) {
+        if (!exportProgress && exportDataset == int(Storage::ExportDataset::Staff)) exportDataset = 0;
+        showExportModal = true;
+    }
     
     ImGui::SameLine();
-    static char searchBuffer[128] = "";
-    ImGui::InputTextWithHint("##search", "Search by name...", searchBuffer, sizeof(searchBuffer));
+    ImGui::InputTextWithHint("##search", "Search name, father, email, phone...", studentSearch, sizeof(studentSearch));
 
     ImGui::Spacing();
     ImGui::Separator();
@@ -703,50 +822,48 @@ void App::RenderStudentList() {
     ImGui::Text("Filter by:");
     ImGui::SameLine();
     
-    auto& classMap = ClassConfig::Get().classesAndSections;
-    std::vector<std::string> classNames;
-    for(auto const& [name, _] : classMap) classNames.push_back(name);
-    
-    if (!classNames.empty()) {
-        // Class Selector
-        if (selectedFilterClassIndex >= classNames.size()) selectedFilterClassIndex = 0;
-        std::string currentFilterClass = classNames[selectedFilterClassIndex];
-        
+    if (!ClassConfig::Get().Classes().empty()) {
         ImGui::SetNextItemWidth(150);
-        if (ImGui::BeginCombo("Class##Filter", currentFilterClass.c_str())) {
-            for (int n = 0; n < classNames.size(); n++) {
-                bool is_selected = (selectedFilterClassIndex == n);
-                if (ImGui::Selectable(classNames[n].c_str(), is_selected))
-                    selectedFilterClassIndex = n;
-                if (is_selected) ImGui::SetItemDefaultFocus();
-            }
-            ImGui::EndCombo();
-        }
+        filterClass.ClassCombo("Class##Filter");
         
         ImGui::SameLine();
         
         // Section Selector
-        auto sections = ClassConfig::Get().GetSections(currentFilterClass);
-        if (!sections.empty()) {
-            if (selectedFilterSectionIndex >= sections.size()) selectedFilterSectionIndex = 0;
-            std::string currentFilterSection = sections[selectedFilterSectionIndex];
-            
+        if (filterClass.Section() != kNoSection) {
             ImGui::SetNextItemWidth(100);
-            if (ImGui::BeginCombo("Section##Filter", currentFilterSection.c_str())) {
-                for (int n = 0; n < sections.size(); n++) {
-                    bool is_selected = (selectedFilterSectionIndex == n);
-                    if (ImGui::Selectable(sections[n].c_str(), is_selected))
-                        selectedFilterSectionIndex = n;
-                    if (is_selected) ImGui::SetItemDefaultFocus();
-                }
-                ImGui::EndCombo();
-            }
+            filterClass.SectionCombo("Section##Filter");
         } else {
             ImGui::TextColored(ImVec4(1, 0.5f, 0, 1), "No sections for this class!");
         }
     } else {
         ImGui::TextColored(ImVec4(1, 0, 0, 1), "No classes configured! Go to Settings.");
     }
+    // The picker holds the filter as symbols; no section means "show everything"
+    if (filterClass.Section() == kNoSection) {
+        RefreshStudentView(kNoSymbol, kNoSymbol);
+    } else {
+        RefreshStudentView(filterClass.ClassSymbol(), filterClass.SectionSymbol());
+    }
+
+    // Actions on the selected rows
+    ImGui::SameLine();
+    ImGui::TextDisabled("|");
+    ImGui::SameLine();
+    if (ImGui::Button("Select All")) { // Every row the filter and search show
+        for (int slot : studentView.rows) studentSelection.SetItemSelected(dataManager.students.Ids()[slot], true);
+    }
+    ImGui::BeginDisabled(studentSelection.Size == 0);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) studentSelection.Clear();
+    ImGui::SameLine();
+    if (ImGui::Button("Move Selected...")) AskMoveStudents(SelectedStudentIds());
+    ImGui::SameLine();
+    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
+    if (ImGui::Button("Delete Selected")) AskDeleteStudents(SelectedStudentIds());
+    ImGui::PopStyleColor();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::TextDisabled("%d selected", studentSelection.Size);
 
     ImGui::Spacing();
 
@@ -768,74 +885,64 @@ void App::RenderStudentList() {
             ImGui::TableSetupColumn("Class", ImGuiTableColumnFlags_WidthFixed, 60.0f);
             ImGui::TableSetupColumn("Section", ImGuiTableColumnFlags_WidthFixed, 60.0f);
             ImGui::TableSetupColumn("Father's Name", ImGuiTableColumnFlags_WidthStretch);
-            ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_WidthFixed, 110.0f);
+            ImGui::TableSetupColumn("Actions", ImGuiTableColumnFlags_WidthFixed, 170.0f);
             ImGui::TableHeadersRow();
 
-            for (auto& s : dataManager.students) {
-                // Filter by selected class and section
-                auto& classMap = ClassConfig::Get().classesAndSections;
-                std::vector<std::string> classNames;
-                for(auto const& [name, _] : classMap) classNames.push_back(name);
-                
-                if (!classNames.empty()) {
-                    std::string filterClass = classNames[selectedFilterClassIndex];
-                    auto sections = ClassConfig::Get().GetSections(filterClass);
-                    
-                    if (!sections.empty()) {
-                        std::string filterSection = sections[selectedFilterSectionIndex];
-                        
-                        // Only show students from selected class and section
-                        if (s.getClassName() != filterClass || s.getSection() != filterSection)
-                            continue;
-                    }
-                }
+            // Rows are items of an ImGui multi-select scope; it reports
+            // selection changes by row index, the storage keeps student IDs
+            const int rowCount = static_cast<int>(studentView.rows.size());
+            studentSelection.UserData = this;
+            studentSelection.AdapterIndexToStorageId = [](ImGuiSelectionBasicStorage* self, int row) {
+                const App* app = static_cast<const App*>(self->UserData);
+                return static_cast<ImGuiID>(app->dataManager.students.Ids()[app->studentView.rows[row]]);
+            };
+            ImGuiMultiSelectIO* selectionIO = ImGui::BeginMultiSelect(
+                ImGuiMultiSelectFlags_ClearOnEscape | ImGuiMultiSelectFlags_BoxSelect1d, studentSelection.Size, rowCount);
+            studentSelection.ApplyRequests(selectionIO);
+
+            // Only the visible rows are submitted, plus the anchor of a Shift+click range
+            ImGuiListClipper clipper;
+            clipper.Begin(rowCount);
+            if (selectionIO->RangeSrcItem != -1) clipper.IncludeItemByIndex(static_cast<int>(selectionIO->RangeSrcItem));
+            while (clipper.Step()) {
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                    StudentTable::ConstRow s = dataManager.students[studentView.rows[row]];
+                    const int id = s.getId();
+                    ImGui::PushID(id); // Row widgets hash an int, no label strings are built
+
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    char roll[16];
+                    std::snprintf(roll, sizeof(roll), "%d", s.getRollNumber());
+                    ImGui::SetNextItemSelectionUserData(row);
+                    ImGui::Selectable(roll, studentSelection.Contains(static_cast<ImGuiID>(id)),
+                                      ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowOverlap);
                 
-                // Simple filter by name
-                if (strlen(searchBuffer) > 0 && s.getName().find(searchBuffer) == std::string::npos)
-                    continue;
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", s.getName().c_str());
 
-                ImGui::TableNextRow();
-                ImGui::TableNextColumn();
-                ImGui::Text("%d", s.getRollNumber());
-                
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", s.getName().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", s.getClassName().c_str());
 
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", s.getClassName().c_str());
-
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", s.getSection().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", s.getSection().c_str());
                 
-                ImGui::TableNextColumn();
-                ImGui::Text("%s", s.getFatherName().c_str());
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%s", s.getFatherName().c_str());
 
-                ImGui::TableNextColumn();
-                if (ImGui::Button(("Profile##" + std::to_string(s.getId())).c_str())) {
-                    selectedStudentId = s.getId();
-                    ImGui::OpenPopup("Student Profile");
-                }
-                ImGui::SameLine();
-                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
-                if (ImGui::Button(("Del##" + std::to_string(s.getId())).c_str())) {
-                    ImGui::OpenPopup(("Delete?" + std::to_string(s.getId())).c_str());
-                }
-                ImGui::PopStyleColor();
-
-                if (ImGui::BeginPopupModal(("Delete?" + std::to_string(s.getId())).c_str(), NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
-                    ImGui::Text("Delete student %s?", s.getName().c_str());
-                    ImGui::Separator();
-                    if (ImGui::Button("Yes", ImVec2(100,0))) {
-                        dataManager.DeleteStudent(s.getId());
-                        ImGui::CloseCurrentPopup();
-                    }
+                    ImGui::TableNextColumn();
+                    if (ImGui::Button("Profile")) selectedStudentId = id; // ShowStudentProfileModal opens it
                     ImGui::SameLine();
-                    if (ImGui::Button("Cancel", ImVec2(100,0))) {
-                        ImGui::CloseCurrentPopup();
-                    }
-                    ImGui::EndPopup();
+                    if (ImGui::Button("Move")) AskMoveStudents({ id });
+                    ImGui::SameLine();
+                    ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.2f, 0.2f, 1.0f));
+                    if (ImGui::Button("Del")) AskDeleteStudents({ id });
+                    ImGui::PopStyleColor();
+                    ImGui::PopID();
                 }
             }
+            selectionIO = ImGui::EndMultiSelect();
+            studentSelection.ApplyRequests(selectionIO);
             ImGui::EndTable();
         }
     }
@@ -848,7 +955,147 @@ void App::RenderStudentList() {
     ImGui::End();
 }
 
+void App::RefreshStudentView(Symbol filterClass, Symbol filterSection) {
+    if (studentView.dataVersion == dataManager.RosterVersion() &&
+        studentView.filterClass == filterClass && studentView.filterSection == filterSection &&
+        studentView.search == studentSearch)
+        return;
+    PROFILE_SCOPE("RefreshStudentView"); // Only rebuilds are timed
+    studentView.dataVersion = dataManager.RosterVersion();
+    studentView.filterClass = filterClass;
+    studentView.filterSection = filterSection;
+    studentView.search = studentSearch;
+
+    studentView.rows.clear();
+
+    // A search lists matches best first, narrowed to the class/section filter
+    if (!studentView.search.empty()) {
+        const StudentTable& students = dataManager.students;
+        for (int i : dataManager.SearchStudents(studentView.search)) {
+            if (filterClass != kNoSymbol && (students.ClassNames()[i] != filterClass || students.Sections()[i] != filterSection))
+                continue;
+            studentView.rows.push_back(i);
+        }
+        return;
+    }
+
+    // A section filter walks that section's member list, not the whole roster
+    std::vector<const SectionIndex::Section*> sections;
+    if (filterClass != kNoSymbol) {
+        if (const SectionIndex::Section* sec = dataManager.FindSection(filterClass, filterSection))
+            sections.push_back(sec);
+    } else {
+        sections = dataManager.Sections().InOrder();
+    }
+
+    for (const SectionIndex::Section* sec : sections)
+        studentView.rows.insert(studentView.rows.end(), sec->members.begin(), sec->members.end());
+}
+
+std::vector<int> App::SelectedStudentIds() {
+    std::vector<int> ids;
+    ids.reserve(studentSelection.Size);
+    void* it = nullptr;
+    for (ImGuiID id; studentSelection.GetNextSelectedItem(&it, &id);) ids.push_back(static_cast<int>(id));
+    return ids;
+}
+
+void App::AskDeleteStudents(std::vector<int> ids) {
+    if (ids.empty()) return;
+    std::string message;
+    std::optional<StudentTable::Row> only = ids.size() == 1 ? dataManager.FindStudent(ids[0]) : std::nullopt;
+    if (only) message = "Delete student " + only->getName() + "?";
+    else message = "Delete " + std::to_string(ids.size()) + " students?";
+    confirmDialog.Ask("Delete Students", message + " This cannot be undone.", "Delete", [this, ids = std::move(ids)] {
+        // One roll renumber per section and one journal record for the lot
+        const bool batch = ids.size() > 1;
+        if (batch) dataManager.BeginBatch();
+        for (int id : ids) {
+            dataManager.DeleteStudent(id);
+            studentSelection.SetItemSelected(static_cast<ImGuiID>(id), false);
+        }
+        if (batch) dataManager.Commit();
+    });
+}
+
+void App::AskMoveStudents(std::vector<int> ids) {
+    if (ids.empty()) return;
+    std::string message;
+    std::optional<StudentTable::Row> only = ids.size() == 1 ? dataManager.FindStudent(ids[0]) : std::nullopt;
+    if (only) message = "Move " + only->getName() + " (" + only->getClassName() + " " + only->getSection() + ") to:";
+    else message = "Move " + std::to_string(ids.size()) + " students to:";
+    // Filled in by the picker while the dialog is open
+    auto target = std::make_shared<std::pair<std::string, std::string>>();
+    confirmDialog.Ask("Move Students", message, "Move",
+        [this, ids = std::move(ids), target] {
+            const bool batch = ids.size() > 1;
+            if (batch) dataManager.BeginBatch();
+            for (int id : ids) dataManager.MoveStudent(id, target->first, target->second);
+            if (batch) dataManager.Commit();
+        },
+        [this, target] { return RenderMoveTarget(target->first, target->second); });
+}
+
+bool App::RenderMoveTarget(std::string& className, std::string& section) {
+    className.clear();
+    section.clear();
+    const ClassConfig& config = ClassConfig::Get();
+    if (config.Classes().empty()) {
+        ImGui::TextColored(ImVec4(1, 0, 0, 1), "No classes configured! Go to Settings.");
+        return false;
+    }
+    ImGui::SetNextItemWidth(150);
+    moveTarget.ClassCombo("Class##Move");
+    if (moveTarget.Section() == kNoSection) {
+        ImGui::TextColored(ImVec4(1, 0.5f, 0, 1), "No sections for this class!");
+        return false;
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100);
+    moveTarget.SectionCombo("Section##Move");
+    className = config.Class(moveTarget.Class()).name;
+    section = config.Section(moveTarget.Section()).name;
+    return true;
+}
+
+void App::AskPromotion() {
+    PromotionPlan plan = PromotionPlan::Default(ClassConfig::Get());
+    plan.resetRecords = promotionResetMarks;
+    std::string archive = PromotionPlan::ArchivePath(promotionLabel);
+    std::vector<std::string> problems = plan.Problems(ClassConfig::Get());
+    DataManager::PromotionSummary preview = dataManager.PreviewPromotion(plan);
+
+    std::string message;
+    for (const PromotionPlan::Step& step : plan.steps) {
+        message += "Class " + step.fromClass + (step.toClass.empty() ? " graduates" : " -> " + step.toClass);
+        for (const auto& [from, to] : step.sections)
+            if (from != to) message += ", section " + from + " -> " + to;
+        message += "\n";
+    }
+    message += "\n" + std::to_string(preview.promoted) + " students move up; " + std::to_string(preview.graduated) +
+               " graduate to " + archive + ".";
+    if (plan.resetRecords) message += "\nPromoted students' marks and attendance are cleared.";
+    for (const std::string& problem : problems) message += "\nCannot promote: " + problem;
+
+    confirmDialog.Ask("End of Year Promotion", message, "Promote",
+        [this, plan = std::move(plan), archive] {
+            DataManager::PromotionSummary summary = dataManager.Promote(plan, archive);
+            studentSelection.Clear(); // Graduates are gone
+            promotionMessage = "Promoted " + std::to_string(summary.promoted) + " students, archived " +
+                               std::to_string(summary.graduated) + " to " + archive + ".";
+        },
+        [ok = problems.empty()] { return ok; });
+}
+
+void App::AskDeleteStaff(int id) {
+    const Staff* s = dataManager.FindStaff(id);
+    if (!s) return;
+    confirmDialog.Ask("Delete Staff", "Delete staff " + s->getName() + "?", "Delete",
+                      [this, id] { dataManager.DeleteStaff(id); });
+}
+
 void App::ShowAddStudentModal() {
+    PROFILE_SCOPE("ShowAddStudentModal");
     ImGui::OpenPopup("Add Student");
     ImVec2 center = ImGui::GetMainViewport()->GetCenter();
     ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
@@ -860,33 +1107,13 @@ void App::ShowAddStudentModal() {
         ImGui::InputText("Contact", inputPhone, sizeof(inputPhone));
         
         // Class Selection
-        auto& mapClasses = ClassConfig::Get().classesAndSections;
-        std::vector<std::string> classNames;
-        for(auto const& [name, _] : mapClasses) classNames.push_back(name);
-
-        if (!classNames.empty()) {
-            if (inputClassIndex >= classNames.size()) inputClassIndex = 0;
-            if (ImGui::Combo("Class", &inputClassIndex, [](void* data, int idx, const char** out_text) {
-                auto& v = *static_cast<std::vector<std::string>*>(data);
-                if (idx < 0 || idx >= v.size()) return false;
-                *out_text = v[idx].c_str();
-                return true;
-            }, &classNames, classNames.size())) {
-                inputSectionIndex = 0; // Reset section on class change
-            }
+        const ClassConfig& config = ClassConfig::Get();
+        if (!config.Classes().empty()) {
+            inputClass.ClassCombo("Class"); // Resets the section on class change
             
             // Section Selection
-            std::string currentClass = classNames[inputClassIndex];
-            auto sections = ClassConfig::Get().GetSections(currentClass);
-            
-             if (!sections.empty()) {
-                if (inputSectionIndex >= sections.size()) inputSectionIndex = 0;
-                ImGui::Combo("Section", &inputSectionIndex, [](void* data, int idx, const char** out_text) {
-                    auto& v = *static_cast<std::vector<std::string>*>(data);
-                    if (idx < 0 || idx >= v.size()) return false;
-                    *out_text = v[idx].c_str();
-                    return true;
-                }, &sections, sections.size());
+             if (inputClass.Section() != kNoSection) {
+                inputClass.SectionCombo("Section");
             } else {
                 ImGui::TextColored(ImVec4(1, 0, 0, 1), "No sections! Add in Settings.");
             }
@@ -900,9 +1127,9 @@ void App::ShowAddStudentModal() {
         ImGui::Spacing();
 
         if (ImGui::Button("Save", ImVec2(120, 0))) {
-            if (!classNames.empty()) {
-                std::string cls = classNames[inputClassIndex];
-                std::string sec = ClassConfig::Get().GetSections(cls).empty() ? "A" : ClassConfig::Get().GetSections(cls)[inputSectionIndex];
+            if (inputClass.Class() != kNoClass) {
+                std::string cls = config.Class(inputClass.Class()).name;
+                std::string sec = inputClass.Section() == kNoSection ? "A" : config.Section(inputClass.Section()).name;
                 
                 Student s(dataManager.getNextStudentId(), inputName, inputEmail, inputPhone, cls, sec, inputFatherName);
                 
@@ -924,11 +1151,166 @@ void App::ShowAddStudentModal() {
     }
 }
 
-void App::Shutdown() {
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
-    ImGui::DestroyContext();
+void App::ShowImportModal() {
+    PROFILE_SCOPE("ShowImportModal");
+    ImGui::OpenPopup("Import Students");
+    ImVec2 center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+
+    if (ImGui::BeginPopupModal("Import Students", NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
+        if (dataManager.ImportPending()) {
+            // The rows are in; search, sections and stats are rebuilt on a worker thread
+            if (dataManager.FinishImport()) {
+                importMessage = "Added " + std::to_string(importSummary.added) + " students, updated " +
+                                std::to_string(importSummary.replaced) + ".";
+            } else {
+                ImGui::Text("Indexing %u students", static_cast<unsigned>(dataManager.students.size()));
+                ImGui::ProgressBar(-1.0f * static_cast<float>(ImGui::GetTime()), ImVec2(400, 0), "Indexing");
+            }
+        } else if (!studentImport) {
+            ImGui::TextDisabled("CSV with a header row. name, class and section are required;");
+            ImGui::TextDisabled("id, father_name, email, phone, attendance and T1:Subject marks are optional.");
+            ImGui::InputText("File", importPath, sizeof(importPath));
+            if (!importMessage.empty()) ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", importMessage.c_str());
+
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+            if (ImGui::Button("Start", ImVec2(120, 0)) && importPath[0] != '\0') {
+                importMessage.clear();
+                studentImport = std::make_unique<Storage::CsvStudentImport>(importPath, ClassConfig::Get(), wake);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Close", ImVec2(120, 0))) {
+                showImportModal = false;
+                ImGui::CloseCurrentPopup();
+            }
+        } else if (!studentImport->Finished()) {
+            // Parsing runs on worker threads; the modal only reports on it
+            ImGui::Text("Reading %s", studentImport->Path().c_str());
+            ImGui::ProgressBar(studentImport->Progress(), ImVec2(400, 0));
+            ImGui::Text("%u rows read", static_cast<unsigned>(studentImport->RowsParsed()));
+
+            ImGui::Spacing();
+            if (ImGui::Button("Cancel", ImVec2(120, 0))) studentImport->Cancel();
+            ImGui::SameLine();
+            if (ImGui::Button("Hide", ImVec2(120, 0))) {
+                showImportModal = false;
+                ImGui::CloseCurrentPopup();
+            }
+        } else if (studentImport->Cancelled() || !studentImport->Failure().empty()) {
+            importMessage = studentImport->Cancelled() ? "Import cancelled." : studentImport->Failure();
+            studentImport.reset();
+        } else {
+            StudentTable& rows = studentImport->Rows();
+            ImGui::Text("%u valid rows read in %.2fs", static_cast<unsigned>(rows.size()), studentImport->Seconds());
+            if (size_t problems = studentImport->IssueCount()) {
+                ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%u rows have problems and will be skipped:",
+                                   static_cast<unsigned>(problems));
+                const std::vector<Storage::CsvIssue>& issues = studentImport->Issues();
+                if (ImGui::BeginChild("ImportIssues", ImVec2(600, 200), true)) {
+                    ImGuiListClipper clipper;
+                    clipper.Begin(static_cast<int>(issues.size()));
+                    while (clipper.Step())
+                        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+                            ImGui::Text("Line %u: %s", static_cast<unsigned>(issues[i].line), issues[i].message.c_str());
+                    if (problems > issues.size())
+                        ImGui::TextDisabled("...and %u more", static_cast<unsigned>(problems - issues.size()));
+                }
+                ImGui::EndChild();
+            }
+
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+            ImGui::BeginDisabled(rows.empty());
+            if (ImGui::Button("Import", ImVec2(120, 0))) {
+                importSummary = dataManager.BeginImport(rows, wake);
+                studentImport.reset();
+            }
+            ImGui::EndDisabled();
+            ImGui::SameLine();
+            if (ImGui::Button("Discard", ImVec2(120, 0))) {
+                importMessage = "Import discarded.";
+                studentImport.reset();
+            }
+        }
+        ImGui::EndPopup();
+    }
+}
+
+void App::ShowExportModal() {
+    PROFILE_SCOPE("ShowExportModal");
+    ImGui::OpenPopup("Export Data");
+    ImVec2 center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+
+    if (ImGui::BeginPopupModal("Export Data", NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
+        if (exportProgress && exportProgress->finished.load(std::memory_order_acquire)) {
+            exportMessage = exportProgress->error.empty()
+                ? "Wrote " + std::to_string(exportProgress->rows) + " rows to " + exportPath + "."
+                : exportProgress->error + ".";
+            exportProgress.reset();
+        }
 
-    glfwDestroyWindow(window);
-    glfwTerminate();
+        if (!exportProgress) {
+            bool renamed = false;
+            renamed |= ImGui::Combo("Data", &exportDataset, "Students\0Marks (one row per mark)\0Staff\0");
+            renamed |= ImGui::Combo("Format", &exportFormat, "CSV\0JSON\0");
+
+            bool students = exportDataset != int(Storage::ExportDataset::Staff);
+            ImGui::BeginDisabled(!students);
+            exportClass.ClassCombo("Class");
+            ImGui::BeginDisabled(exportClass.Class() == kNoClass);
+            exportClass.SectionCombo("Section");
+            ImGui::EndDisabled();
+            ImGui::Combo("Term", &exportTerm, "All\0Term 1\0Term 2\0Term 3\0Term 4\0");
+            ImGui::EndDisabled();
+
+            // Keep the suggested file name in step with the dataset and format
+            if (renamed) {
+                const char* base = exportDataset == int(Storage::ExportDataset::Marks) ? "marks"
+                                 : exportDataset == int(Storage::ExportDataset::Staff) ? "staff" : "students";
+                const char* extension = exportFormat == int(Storage::ExportFormat::Json) ? ".json" : ".csv";
+                snprintf(exportPath, sizeof(exportPath), "%s%s", base, extension);
+            }
+            ImGui::InputText("File", exportPath, sizeof(exportPath));
+            if (!exportMessage.empty()) ImGui::TextColored(ImVec4(0.4f, 0.8f, 1.0f, 1.0f), "%s", exportMessage.c_str());
+
+            ImGui::Spacing();
+            ImGui::Separator();
+            ImGui::Spacing();
+            if (ImGui::Button("Export", ImVec2(120, 0)) && exportPath[0] != '\0') {
+                Storage::ExportOptions options;
+                options.dataset = static_cast<Storage::ExportDataset>(exportDataset);
+                options.format = static_cast<Storage::ExportFormat>(exportFormat);
+                options.path = exportPath;
+                const ClassConfig& config = ClassConfig::Get();
+                if (students && exportClass.Class() != kNoClass) {
+                    options.className = config.Class(exportClass.Class()).name;
+                    if (exportClass.Section() != kNoSection) options.section = config.Section(exportClass.Section()).name;
+                }
+                if (students) options.term = exportTerm;
+                exportMessage.clear();
+                exportProgress = dataManager.Export(std::move(options));
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Close", ImVec2(120, 0))) {
+                showExportModal = false;
+                ImGui::CloseCurrentPopup();
+            }
+        } else {
+            // Written on the persistence thread; the modal only reports on it
+            ImGui::Text("Writing %s", exportPath);
+            ImGui::ProgressBar(exportProgress->Fraction(), ImVec2(400, 0));
+            ImGui::Spacing();
+            if (ImGui::Button("Cancel", ImVec2(120, 0))) exportProgress->cancel = true;
+            ImGui::SameLine();
+            if (ImGui::Button("Hide", ImVec2(120, 0))) {
+                showExportModal = false;
+                ImGui::CloseCurrentPopup();
+            }
+        }
+        ImGui::EndPopup();
+    }
 }
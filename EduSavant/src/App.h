@@ -1,22 +1,29 @@
 #pragma once
 
 #include "imgui.h"
-#include "imgui_impl_glfw.h"
-#include "imgui_impl_opengl3.h"
 #include <stdio.h>
-#define GL_SILENCE_DEPRECATION
-#include <GLFW/glfw3.h>
+#include <functional>
+#include <memory>
 #include "DataManager.h"
+#include "Storage/CsvImport.h"
+#include "UI/ClassPicker.h"
+#include "UI/ConfirmDialog.h"
+#include "UI/FrameSettings.h"
+#include "UI/ProfilerOverlay.h"
 
+struct GLFWwindow;
 
+// The screens (App.cpp) only talk to ImGui; the window, GL context and render
+// loop live in AppWindow.cpp. That keeps the screens buildable without GLFW,
+// which bench/UiBench.cpp relies on to drive them on the null backend.
 class App {
 public:
-    App();
-    ~App();
-
+    // Opens the window, runs until it is closed, then tears it down.
     void Run();
 
 private:
+    friend class UiBench;
+
     void Init();
     void Shutdown();
     
@@ -25,6 +32,9 @@ private:
 
     // Application Data
     DataManager dataManager;
+    FrameSettings frameSettings;
+    ProfilerOverlay profilerOverlay;
+    std::function<void()> wake; // Asks the render loop for a frame; safe from any thread, empty when headless
     
     // UI State
     enum class Screen { Dashboard, Students, Teachers, Settings };
@@ -32,6 +42,8 @@ private:
 
     bool showAddStudentModal = false;
     bool showAddTeacherModal = false;
+    bool showImportModal = false;
+    bool showExportModal = false;
     int selectedStudentId = -1;
 
     // Temporary variables for input - Students
@@ -39,8 +51,7 @@ private:
     char inputEmail[128] = "";
     char inputPhone[128] = "";
     char inputFatherName[128] = "";
-    int inputClassIndex = 0; // Index in available classes
-    int inputSectionIndex = 0; // Index in available sections
+    ClassPicker inputClass;
 
     // Temporary variables for input - Staff
     char inputStaffName[128] = "";
@@ -53,13 +64,68 @@ private:
     char inputNewClassName[64] = "";
     char inputNewSectionName[64] = "";
     char inputNewSubjectName[64] = "";
-    int selectedClassConfigIndex = 0;
+    ClassPicker configClass; // Class and section being edited
     
     // Student List Filter State
-    int selectedFilterClassIndex = 0;
-    int selectedFilterSectionIndex = 0;
+    ClassPicker filterClass;
+    char studentSearch[128] = "";
+    char staffSearch[128] = "";
+
+    // Slots of the rows that pass the current filter, rebuilt only when the
+    // data version, the class/section filter or the search text changes.
+    // The class/section filter comes from filterClass as symbols;
+    // kNoSymbol for the class means "all students".
+    struct TableView {
+        std::vector<int> rows;
+        uint64_t dataVersion = UINT64_MAX;
+        Symbol filterClass = kNoSymbol;
+        Symbol filterSection = kNoSymbol;
+        std::string search;
+    };
+    TableView studentView;
+    TableView staffView;
+    // Bulk CSV import; parses in the background while the modal shows progress
+    std::unique_ptr<Storage::CsvStudentImport> studentImport;
+    char importPath[260] = "students.csv";
+    std::string importMessage; // Outcome of the last import, shown in the modal
+    DataManager::ImportSummary importSummary; // Of the import whose indexes are being built
+
+    // Export; runs on the persistence thread and reports through exportProgress
+    std::shared_ptr<Storage::ExportProgress> exportProgress;
+    int exportDataset = 0;      // Storage::ExportDataset
+    int exportFormat = 0;       // Storage::ExportFormat
+    ClassPicker exportClass{ true }; // "All" = no filter
+    int exportTerm = 0;         // 0 = all terms
+    char exportPath[260] = "students.csv";
+    std::string exportMessage;
+
+    // Row actions: the shared confirm dialog, the students selected in the
+    // list (click, Ctrl/Shift+click, drag, Ctrl+A), and the target picked in
+    // the move dialog
+    ConfirmDialog confirmDialog;
+    ImGuiSelectionBasicStorage studentSelection; // Keyed by student ID, so it survives filtering and re-sorting
+    ClassPicker moveTarget;
+
+    // Dashboard analytics panel; computed only while it is open
+    bool analyticsOpen = false;
+    ClassPicker analyticsScope{ true }; // "All" = the whole school or class
+    int analyticsTerm = 0;              // 0-based
+
+    // End-of-year promotion (Settings)
+    char promotionLabel[32] = ""; // Archive name; empty = current year
+    bool promotionResetMarks = false;
+    std::string promotionMessage; // Outcome of the last promotion
+
+    bool Busy() const; // A background job with a progress bar on screen is running
+
+    // One frame of UI between ImGui::NewFrame() and ImGui::Render()
+    void RenderFrame();
+
+    void RefreshStudentView(Symbol filterClass, Symbol filterSection);
+    void RefreshStaffView();
 
     void RenderDashboard();
+    void RenderAnalytics(); // Dashboard panel: subject statistics and section ranking
     void RenderStudentList();
     void RenderStaffList(); // Renamed from TeacherList
     void RenderSettings();
@@ -68,5 +134,14 @@ private:
     void ShowAddStudentModal();
     void ShowAddStaffModal(); // Renamed
     void ShowStudentProfileModal(); // New
+    void ShowImportModal();
+    void ShowExportModal();
+
+    std::vector<int> SelectedStudentIds();
+    void AskDeleteStudents(std::vector<int> ids);
+    void AskMoveStudents(std::vector<int> ids);
+    void AskDeleteStaff(int id);
+    void AskPromotion();
+    bool RenderMoveTarget(std::string& className, std::string& section); // Move dialog body; true once a section is picked
 };
 
@@ -0,0 +1,143 @@
+#include "App.h"
+#include "UI/FramePacer.h"
+#include "UI/Theme.h"
+#include "imgui_impl_glfw.h"
+#include "imgui_impl_opengl3.h"
+#include <cstdlib>
+#define GL_SILENCE_DEPRECATION
+#include <GLFW/glfw3.h>
+
+static void glfw_error_callback(int error, const char* description) {
+    fprintf(stderr, "GLFW Error %d: %s\n", error, description);
+}
+
+void App::Init() {
+    glfwSetErrorCallback(glfw_error_callback);
+
+    printf("--- EduSavant (Debug Build) ---\n");
+    printf("DISPLAY: %s\n", getenv("DISPLAY"));
+    printf("Setting GLFW_PLATFORM = x11\n");
+
+    // Force X11 backend using environment variable
+    setenv("GLFW_PLATFORM", "x11", 1);
+
+    if (!glfwInit()) {
+        fprintf(stderr, "Failed to initialize GLFW. Ensure X11/Wayland is correctly configured.\n");
+        std::exit(1);
+    }
+
+    // GL 3.0 + GLSL 130
+    glsl_version = "#version 130";
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 0);
+
+    window = glfwCreateWindow(1280, 800, "EduSavant - School Management System", nullptr, nullptr);
+    if (window == nullptr)
+        std::exit(1);
+
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(1); // Enable vsync
+
+    // Setup Dear ImGui context
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO(); (void)io;
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
+    io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
+
+    // Setup Dear ImGui style
+    Theme::Setup();
+
+    // When viewports are enabled we tweak WindowRounding/WindowBg so platform windows can look identical to regular ones.
+    ImGuiStyle& style = ImGui::GetStyle();
+    if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+    {
+        style.WindowRounding = 0.0f;
+        style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+    }
+
+    // Setup Platform/Renderer backends
+    ImGui_ImplGlfw_InitForOpenGL(window, true);
+    ImGui_ImplOpenGL3_Init(glsl_version);
+
+    // Finished saves and imports count as reasons to redraw
+    wake = [] { FramePacer::RequestFrame(); };
+    dataManager.SetWakeCallback(wake);
+}
+
+void App::Run() {
+    Init();
+    ImGuiIO& io = ImGui::GetIO();
+    ImVec4 clear_color = ImVec4(0.11f, 0.15f, 0.17f, 1.00f);
+
+    // Redraw only when something changed
+    FramePacer framePacer(frameSettings);
+    framePacer.Attach(window);
+
+    while (!glfwWindowShouldClose(window)) {
+        framePacer.WaitForFrame(window, Busy());
+        Profiler& profiler = Profiler::Get();
+        profiler.BeginFrame();
+
+        // Start the Dear ImGui frame
+        {
+            PROFILE_SCOPE("NewFrame");
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
+        }
+
+        {
+            PROFILE_SCOPE("RenderFrame");
+            RenderFrame();
+        }
+
+        // Rendering
+        {
+            PROFILE_SCOPE("ImGui::Render");
+            ImGui::Render();
+        }
+        {
+            PROFILE_SCOPE("GL draw");
+            int display_w, display_h;
+            glfwGetFramebufferSize(window, &display_w, &display_h);
+            glViewport(0, 0, display_w, display_h);
+            glClearColor(clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+
+            // Update and Render additional Platform Windows
+            if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+            {
+                GLFWwindow* backup_current_context = glfwGetCurrentContext();
+                ImGui::UpdatePlatformWindows();
+                ImGui::RenderPlatformWindowsDefault();
+                glfwMakeContextCurrent(backup_current_context);
+            }
+        }
+
+        {
+            PROFILE_SCOPE("SwapBuffers"); // Includes waiting for vsync
+            glfwSwapBuffers(window);
+        }
+        profiler.EndFrame();
+    }
+    Shutdown();
+}
+
+void App::Shutdown() {
+    // Pending saves may finish after GLFW is gone; stop them waking the loop
+    studentImport.reset(); // Cancels and joins a running import
+    dataManager.SetWakeCallback(nullptr);
+    dataManager.Flush();
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    window = nullptr;
+}
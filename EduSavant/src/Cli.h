@@ -0,0 +1,327 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "DataManager.h"
+#include "Storage/CsvImport.h"
+#include "Storage/Export.h"
+
+// Headless batch mode: the same DataManager the UI uses, driven from the
+// command line with no window, GL context or ImGui. Built on its own as
+// EduSavant-cli (cli_main.cpp, no GLFW at link time) and also reachable as
+// `EduSavant --batch ...`. Meant for nightly jobs on display-less servers.
+namespace Cli {
+
+// Process exit codes
+enum Status {
+    kOk = 0,
+    kUsage = 1,       // Bad command line
+    kDataProblems = 2, // Rejected import rows, failed validation
+    kIoError = 3,     // Unreadable input, unwritable output, failed save
+};
+
+inline void PrintUsage(const char* program) {
+    fprintf(stderr,
+        "Usage: %s [--data <dir>] <command> [options]\n"
+        "\n"
+        "Commands:\n"
+        "  import <file.csv> [--dry-run] [--strict]\n"
+        "      Bulk-load students. --dry-run only validates; --strict imports\n"
+        "      nothing if any row is rejected.\n"
+        "  export <students|marks|staff> <file> [--format csv|json]\n"
+        "         [--class <name>] [--section <name>] [--term <1-4>]\n"
+        "      Format defaults to the file extension.\n"
+        "  compact\n"
+        "      Folds the journal into a fresh students.db snapshot.\n"
+        "  validate\n"
+        "      Checks students against the class configuration and roll order.\n"
+        "  stats\n"
+        "      Prints the dashboard figures.\n"
+        "  promote [--label <year>] [--reset-marks] [--dry-run]\n"
+        "      End of year: moves every class up one (natural order, sections\n"
+        "      kept by name where possible) and archives the last class to\n"
+        "      archive/graduates-<year>.db. --reset-marks clears marks and\n"
+        "      attendance of promoted students.\n"
+        "\n"
+        "Exit status: 0 ok, 1 usage, 2 data problems, 3 I/O error.\n",
+        program);
+}
+
+// Pulls "--name value" out of args; returns false if the flag is present
+// without a value.
+inline bool TakeOption(std::vector<std::string>& args, std::string_view name, std::string& value) {
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] != name) continue;
+        if (i + 1 == args.size()) return false;
+        value = args[i + 1];
+        args.erase(args.begin() + i, args.begin() + i + 2);
+        return true;
+    }
+    return true;
+}
+
+inline bool TakeFlag(std::vector<std::string>& args, std::string_view name) {
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] != name) continue;
+        args.erase(args.begin() + i);
+        return true;
+    }
+    return false;
+}
+
+// Writes everything outstanding; a failed save is an I/O error.
+inline int FlushData(DataManager& data) {
+    data.Flush();
+    if (data.GetSaveStatus() == Storage::PersistenceService::Status::Failed) {
+        fprintf(stderr, "error: saving failed (check disk space and permissions)\n");
+        return kIoError;
+    }
+    return kOk;
+}
+
+inline int Import(DataManager& data, std::vector<std::string> args, const std::filesystem::path& cwd) {
+    bool dryRun = TakeFlag(args, "--dry-run");
+    bool strict = TakeFlag(args, "--strict");
+    if (args.size() != 1) return kUsage;
+
+    Storage::CsvStudentImport import((cwd / args[0]).string(), ClassConfig::Get());
+    while (!import.Finished()) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    if (!import.Failure().empty()) {
+        fprintf(stderr, "error: %s\n", import.Failure().c_str());
+        return kIoError;
+    }
+    for (const Storage::CsvIssue& issue : import.Issues())
+        fprintf(stderr, "%s:%zu: %s\n", args[0].c_str(), issue.line, issue.message.c_str());
+    if (import.IssueCount() > import.Issues().size())
+        fprintf(stderr, "...and %zu more rejected rows\n", import.IssueCount() - import.Issues().size());
+    printf("%zu valid rows, %zu rejected, parsed in %.2fs\n", import.Rows().size(), import.IssueCount(), import.Seconds());
+
+    int status = import.IssueCount() ? kDataProblems : kOk;
+    if (dryRun || (strict && import.IssueCount())) {
+        printf("Nothing imported\n");
+        return status;
+    }
+    DataManager::ImportSummary summary = data.ImportStudents(import.Rows());
+    printf("Added %zu students, updated %zu\n", summary.added, summary.replaced);
+    int saved = FlushData(data);
+    return saved != kOk ? saved : status;
+}
+
+inline int Export(DataManager& data, std::vector<std::string> args, const std::filesystem::path& cwd) {
+    Storage::ExportOptions options;
+    std::string format, term;
+    if (!TakeOption(args, "--format", format) || !TakeOption(args, "--class", options.className) ||
+        !TakeOption(args, "--section", options.section) || !TakeOption(args, "--term", term) || args.size() != 2)
+        return kUsage;
+
+    if (args[0] == "students") options.dataset = Storage::ExportDataset::Students;
+    else if (args[0] == "marks") options.dataset = Storage::ExportDataset::Marks;
+    else if (args[0] == "staff") options.dataset = Storage::ExportDataset::Staff;
+    else return kUsage;
+
+    options.path = (cwd / args[1]).string();
+    if (format.empty()) format = std::filesystem::path(options.path).extension() == ".json" ? "json" : "csv";
+    if (format == "json") options.format = Storage::ExportFormat::Json;
+    else if (format != "csv") return kUsage;
+
+    if (!term.empty()) {
+        options.term = std::atoi(term.c_str());
+        if (options.term < 1 || options.term > MarkSheet::kTerms) return kUsage;
+    }
+
+    std::shared_ptr<Storage::ExportProgress> progress = data.Export(options);
+    int saved = FlushData(data); // Runs the export, queued behind any snapshot it needs
+    if (!progress->error.empty()) {
+        fprintf(stderr, "error: %s\n", progress->error.c_str());
+        return kIoError;
+    }
+    printf("Wrote %zu rows to %s\n", progress->rows, args[1].c_str());
+    return saved;
+}
+
+inline uintmax_t FileSize(const char* path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    return ec ? 0 : size;
+}
+
+inline int Compact(DataManager& data) {
+    uintmax_t before = FileSize("students.db") + FileSize("students.journal");
+    data.SaveStudents(); // Snapshot now; rotated journal segments are deleted once it lands
+    int status = FlushData(data);
+    uintmax_t after = FileSize("students.db") + FileSize("students.journal");
+    printf("Compacted %zu students: %ju -> %ju bytes\n", data.students.size(), before, after);
+    return status;
+}
+
+inline int Validate(DataManager& data) {
+    size_t problems = 0;
+    auto report = [&problems](int id, const std::string& message) {
+        printf("student %d: %s\n", id, message.c_str());
+        ++problems;
+    };
+
+    const ClassConfig& config = ClassConfig::Get();
+    const StudentTable& students = data.students;
+    for (int slot = 0; slot < static_cast<int>(students.size()); ++slot) {
+        StudentTable::ConstRow s = students[slot];
+        const std::string& cls = s.getClassName();
+        const std::string& sec = s.getSection();
+        if (s.getName().empty()) report(s.getId(), "name is empty");
+        float attendance = s.getAttendance();
+        if (!std::isfinite(attendance) || attendance < 0.0f || attendance > 100.0f)
+            report(s.getId(), "attendance " + std::to_string(attendance) + " is outside 0-100");
+
+        ClassId classId = config.FindClass(s.getClassSymbol());
+        if (classId == kNoClass) {
+            report(s.getId(), "class \"" + cls + "\" is not configured");
+            continue;
+        }
+        SectionId sectionId = config.FindSection(classId, s.getSectionSymbol());
+        if (sectionId == kNoSection) {
+            report(s.getId(), "class " + cls + " has no section \"" + sec + "\"");
+            continue;
+        }
+        Span<Symbol> subjects = config.Subjects(sectionId);
+        s.getMarks().ForEach([&](int term, Symbol subject, int score) {
+            std::string where = "term " + std::to_string(term) + " " + SymbolTable::Get().Str(subject);
+            if (std::find(subjects.begin(), subjects.end(), subject) == subjects.end())
+                report(s.getId(), where + " is not taught in " + cls + "-" + sec);
+            if (score < 0 || score > 100) report(s.getId(), where + " mark " + std::to_string(score) + " is outside 0-100");
+        });
+    }
+
+    // Roll numbers are 1..n in roll order within every section
+    for (const SectionIndex::Section* sec : data.Sections().InOrder()) {
+        for (size_t i = 0; i < sec->members.size(); ++i) {
+            StudentTable::ConstRow s = students[sec->members[i]];
+            if (s.getRollNumber() != static_cast<int>(i) + 1)
+                report(s.getId(), "roll number " + std::to_string(s.getRollNumber()) + ", expected " + std::to_string(i + 1));
+        }
+    }
+
+    printf("%zu students checked, %zu problems\n", students.size(), problems);
+    return problems ? kDataProblems : kOk;
+}
+
+inline int Stats(DataManager& data) {
+    const RosterStats& stats = data.Stats();
+    const SymbolTable& symbols = SymbolTable::Get();
+    printf("Students: %zu\nStaff: %zu\n", stats.Count(), data.staffMembers.size());
+    printf("Attendance: mean %.1f%%, min %.1f%%, max %.1f%%\n",
+           stats.MeanAttendance(), stats.MinAttendance(), stats.MaxAttendance());
+
+    printf("\n%-10s %-8s %8s %11s\n", "Class", "Section", "Students", "Attendance");
+    for (const SectionIndex::Section* sec : data.Sections().InOrder()) {
+        RosterStats::Group g = stats.Section(sec->className, sec->section);
+        if (g.count == 0) continue;
+        printf("%-10s %-8s %8u %10.1f%%\n", symbols.Str(sec->className).c_str(), symbols.Str(sec->section).c_str(),
+               g.count, g.MeanAttendance());
+    }
+
+    bool header = false;
+    for (const RosterStats::SubjectRow& row : stats.Subjects()) { // By name: stable output for diffing
+        std::string_view name = symbols.View(row.subject);
+        for (int term = 1; term <= MarkSheet::kTerms; ++term) {
+            const RosterStats::Score& score = row.terms[term - 1];
+            if (score.count == 0) continue;
+            if (!header) printf("\n%-16s %4s %8s %6s\n", "Subject", "Term", "Marks", "Mean");
+            header = true;
+            printf("%-16.*s %4d %8u %6.1f\n", int(name.size()), name.data(), term, score.count, score.Mean());
+        }
+    }
+    return kOk;
+}
+
+inline int Promote(DataManager& data, std::vector<std::string> args) {
+    std::string label;
+    bool dryRun = TakeFlag(args, "--dry-run");
+    PromotionPlan plan = PromotionPlan::Default(ClassConfig::Get());
+    plan.resetRecords = TakeFlag(args, "--reset-marks");
+    if (!TakeOption(args, "--label", label) || !args.empty()) return kUsage;
+
+    for (const PromotionPlan::Step& step : plan.steps) {
+        printf("%-10s -> %s\n", step.fromClass.c_str(), step.toClass.empty() ? "(graduates)" : step.toClass.c_str());
+        for (const auto& [from, to] : step.sections)
+            if (from != to) printf("    section %s -> %s\n", from.c_str(), to.c_str());
+    }
+    std::vector<std::string> problems = plan.Problems(ClassConfig::Get());
+    for (const std::string& problem : problems) fprintf(stderr, "error: %s\n", problem.c_str());
+    if (!problems.empty()) return kDataProblems;
+
+    std::string archive = PromotionPlan::ArchivePath(label);
+    if (dryRun) {
+        DataManager::PromotionSummary preview = data.PreviewPromotion(plan);
+        printf("Would promote %zu students and archive %zu to %s; nothing changed\n",
+               preview.promoted, preview.graduated, archive.c_str());
+        return kOk;
+    }
+    DataManager::PromotionSummary summary = data.Promote(plan, archive);
+    int status = FlushData(data);
+    if (status != kOk) {
+        fprintf(stderr, "error: nothing was promoted; students.db and %s are unchanged\n", archive.c_str());
+        return status;
+    }
+    printf("Promoted %zu students, archived %zu to %s, %zu unchanged\n",
+           summary.promoted, summary.graduated, archive.c_str(), summary.unchanged);
+    return status;
+}
+
+// `program` is how the usage text names the command; argv holds only the
+// arguments after it.
+inline int Run(const char* program, int argc, char** argv) {
+    std::vector<std::string> args(argv, argv + argc);
+    std::string dataDir;
+    if (!args.empty() && (args[0] == "--help" || args[0] == "-h")) {
+        PrintUsage(program);
+        return kOk;
+    }
+    if (!TakeOption(args, "--data", dataDir) || args.empty()) {
+        PrintUsage(program);
+        return kUsage;
+    }
+    std::error_code ec;
+    std::filesystem::path cwd = std::filesystem::current_path(ec); // File arguments stay relative to this
+    if (!dataDir.empty()) {
+        std::filesystem::current_path(dataDir, ec); // The data files are relative to the working directory
+        if (ec) {
+            fprintf(stderr, "error: cannot use data directory %s: %s\n", dataDir.c_str(), ec.message().c_str());
+            return kIoError;
+        }
+    }
+
+    std::string command = args[0];
+    args.erase(args.begin());
+    static const char* const kCommands[] = { "import", "export", "compact", "validate", "stats", "promote" };
+    if (std::find_if(std::begin(kCommands), std::end(kCommands), [&](const char* c) { return command == c; }) == std::end(kCommands)) {
+        fprintf(stderr, "error: unknown command \"%s\"\n\n", command.c_str());
+        PrintUsage(program);
+        return kUsage;
+    }
+
+    DataManager data; // Loads the roster, replaying any journal
+    if (data.StudentsUnreadable()) {
+        fprintf(stderr, "error: students.db is corrupt or from a newer version; nothing was done\n");
+        return kIoError;
+    }
+    int status = kUsage;
+    if (command == "import") status = Import(data, args, cwd);
+    else if (command == "export") status = Export(data, args, cwd);
+    else if (command == "compact" && args.empty()) status = Compact(data);
+    else if (command == "validate" && args.empty()) status = Validate(data);
+    else if (command == "stats" && args.empty()) status = Stats(data);
+    else if (command == "promote") status = Promote(data, args);
+    if (status == kUsage) PrintUsage(program);
+    return status;
+}
+
+} // namespace Cli
@@ -0,0 +1,139 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// One column of a table, stored as fixed-size chunks behind shared_ptr.
+// Copying a column copies only the chunk pointers: the copies share every
+// chunk until one of them writes, and a write first clones the one chunk it
+// lands in if anyone else still holds it (copy-on-write). A copy is
+// therefore an O(size / kChunkSize) snapshot that stays unchanged while the
+// original goes on being edited; another thread may read it meanwhile.
+// Only the owning thread may copy or write a column.
+//
+// Each chunk's data pointer is cached next to an "owned" stamp, so a read is
+// one extra indexed load over a plain vector and a write to a chunk already
+// known to be exclusive skips the reference count. Copying the column
+// invalidates every stamp, on both sides, by moving to a new `epoch`.
+template <typename T>
+class CowColumn {
+public:
+    static constexpr size_t kChunkShift = 12;
+    static constexpr size_t kChunkSize = size_t(1) << kChunkShift;
+
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator(const CowColumn* column, size_t i) : column(column), i(i) {}
+        const T& operator*() const { return (*column)[i]; }
+        const T* operator->() const { return &(*column)[i]; }
+        Iterator& operator++() { ++i; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++i; return old; }
+        bool operator==(const Iterator& o) const { return i == o.i; }
+        bool operator!=(const Iterator& o) const { return i != o.i; }
+
+    private:
+        const CowColumn* column;
+        size_t i;
+    };
+
+    CowColumn() = default;
+    CowColumn(CowColumn&&) = default;
+    CowColumn& operator=(CowColumn&&) = default;
+
+    // Both sides move to a new epoch: every chunk is shared now.
+    CowColumn(const CowColumn& other)
+        : chunks(other.chunks), slots(other.slots), count(other.count), epoch(++other.epoch) {}
+
+    CowColumn& operator=(const CowColumn& other) {
+        if (this == &other) return *this;
+        chunks = other.chunks;
+        slots = other.slots;
+        count = other.count;
+        epoch = ++other.epoch;
+        return *this;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, count); }
+
+    const T& operator[](size_t i) const { return slots[i >> kChunkShift].data[i & kMask]; }
+
+    // The element, writable; clones its chunk first if it is shared.
+    T& Mutable(size_t i) { return Own(i >> kChunkShift)[i & kMask]; }
+
+    void push_back(T value) {
+        if ((count & kMask) == 0) {
+            chunks.push_back(std::make_shared<Chunk>());
+            slots.push_back({ nullptr, 0 });
+        }
+        size_t c = chunks.size() - 1;
+        Own(c).push_back(std::move(value));
+        slots[c].data = chunks[c]->data(); // push_back may have moved it
+        ++count;
+    }
+
+    void pop_back() {
+        --count;
+        if ((count & kMask) == 0) {
+            chunks.pop_back();
+            slots.pop_back();
+        } else {
+            Own(chunks.size() - 1).pop_back();
+        }
+    }
+
+    void clear() {
+        chunks.clear();
+        slots.clear();
+        count = 0;
+    }
+
+    void reserve(size_t n) {
+        chunks.reserve((n + kMask) >> kChunkShift);
+        slots.reserve((n + kMask) >> kChunkShift);
+    }
+
+private:
+    using Chunk = std::vector<T>;
+    static constexpr size_t kMask = kChunkSize - 1;
+
+    struct Slot {
+        T* data;         // chunks[c]->data()
+        uint32_t owned;  // == epoch once chunks[c] is known to be ours alone
+    };
+
+    Chunk& Own(size_t c) {
+        Slot& slot = slots[c];
+        std::shared_ptr<Chunk>& chunk = chunks[c];
+        if (slot.owned != epoch) {
+            if (chunk.use_count() > 1) {
+                auto copy = std::make_shared<Chunk>();
+                copy->reserve(kChunkSize);
+                copy->assign(chunk->begin(), chunk->end());
+                chunk = std::move(copy);
+            } else {
+                // Whoever dropped the last other reference has finished reading
+                // the chunk; pairs with the release in its shared_ptr decrement.
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+            slot = { chunk->data(), epoch };
+        }
+        return *chunk;
+    }
+
+    std::vector<std::shared_ptr<Chunk>> chunks;
+    std::vector<Slot> slots;
+    size_t count = 0;
+    mutable uint32_t epoch = 1; // Stamps from before the last copy don't count
+};
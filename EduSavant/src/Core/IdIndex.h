@@ -0,0 +1,96 @@
+#pragma once
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Maps a record ID to its slot in a std::vector. Open addressing with linear
+// probing in one flat array (no per-entry allocation); erase uses backward
+// shifting, so there are no tombstones and probe chains stay short.
+class IdIndex {
+public:
+    static constexpr int kNotFound = -1;
+
+    int Find(int id) const {
+        if (entries.empty()) return kNotFound;
+        for (size_t i = Home(id);; i = (i + 1) & mask) {
+            if (entries[i].id == id) return entries[i].slot;
+            if (entries[i].id == kEmpty) return kNotFound;
+        }
+    }
+
+    // Inserts or updates id -> slot.
+    void Insert(int id, int slot) {
+        if ((count + 1) * 2 > entries.size()) Grow();
+        for (size_t i = Home(id);; i = (i + 1) & mask) {
+            if (entries[i].id == id) { entries[i].slot = slot; return; }
+            if (entries[i].id == kEmpty) {
+                entries[i] = { id, slot };
+                ++count;
+                return;
+            }
+        }
+    }
+
+    void Erase(int id) {
+        if (entries.empty()) return;
+        size_t i = Home(id);
+        while (entries[i].id != id) {
+            if (entries[i].id == kEmpty) return;
+            i = (i + 1) & mask;
+        }
+        // Shift later members of the probe chain back into the hole.
+        for (size_t j = (i + 1) & mask; entries[j].id != kEmpty; j = (j + 1) & mask) {
+            size_t home = Home(entries[j].id);
+            bool movable = (i <= j) ? (home <= i || home > j) : (home <= i && home > j);
+            if (movable) {
+                entries[i] = entries[j];
+                i = j;
+            }
+        }
+        entries[i].id = kEmpty;
+        --count;
+    }
+
+    void Clear() {
+        entries.assign(entries.size(), Entry{});
+        count = 0;
+    }
+
+    void Reserve(size_t n) {
+        while (entries.size() < n * 2) Grow();
+    }
+
+    size_t Size() const { return count; }
+
+private:
+    static constexpr int kEmpty = INT_MIN;
+
+    struct Entry {
+        int id = kEmpty;
+        int slot = kNotFound;
+    };
+
+    size_t Home(int id) const {
+        // Fibonacci hashing spreads sequential IDs across the table.
+        return static_cast<size_t>((static_cast<uint32_t>(id) * 2654435769u) >> shift) & mask;
+    }
+
+    void Grow() {
+        std::vector<Entry> old;
+        old.swap(entries);
+        size_t capacity = old.empty() ? 16 : old.size() * 2;
+        entries.assign(capacity, Entry{});
+        mask = capacity - 1;
+        shift = 32;
+        for (size_t c = capacity; c > 1; c >>= 1) --shift;
+        count = 0;
+        for (const Entry& e : old)
+            if (e.id != kEmpty) Insert(e.id, e.slot);
+    }
+
+    std::vector<Entry> entries;
+    size_t count = 0;
+    size_t mask = 0;
+    int shift = 32;
+};
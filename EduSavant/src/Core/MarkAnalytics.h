@@ -0,0 +1,418 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Core/Profiler.h"
+#include "Core/SectionIndex.h"
+#include "Core/SymbolTable.h"
+#include "Core/WorkerPool.h"
+#include "Models/ClassConfig.h"
+#include "Models/StudentTable.h"
+
+// Class-wide views of the marks, for every configured section, every class
+// and the whole school: each subject's mean, standard deviation, percentile
+// bands and grade histogram per term, and every student's rank in their
+// section by term average.
+struct MarkReport {
+    // Letter grades, best first, with the lowest mark of each.
+    struct Grade { const char* name; int minMark; };
+    static constexpr int kGrades = 8;
+    static constexpr Grade kGradeBands[kGrades] = {
+        { "A+", 90 }, { "A", 80 }, { "B+", 70 }, { "B", 60 }, { "C+", 50 }, { "C", 40 }, { "D", 35 }, { "NG", 0 },
+    };
+
+    // One subject in one term, over a group of students.
+    struct SubjectStats {
+        Symbol subject = kEmptySymbol;
+        uint32_t count = 0; // Students with a mark
+        float mean = 0.0f;
+        float stddev = 0.0f; // Population
+        uint8_t min = 0, p25 = 0, median = 0, p75 = 0, p90 = 0, max = 0; // Nearest-rank percentiles
+        uint32_t grades[kGrades] = {}; // Students per grade band
+    };
+
+    struct RankedStudent {
+        int id;         // Student ID; the report may be older than the roster
+        float average;  // Over the subjects marked that term
+        uint32_t rank;  // 1 = best; ties share a rank
+    };
+
+    struct Group {
+        Symbol className = kNoSymbol; // kNoSymbol: the whole school
+        Symbol section = kNoSymbol;   // kNoSymbol: a whole class
+        uint32_t students = 0;
+        // Per term: a section's subjects in ClassConfig order; a class's or
+        // the school's every subject taught in it, by name
+        std::vector<SubjectStats> subjects[MarkSheet::kTerms];
+        // Sections only, per term: students with a mark that term, best first
+        std::vector<RankedStudent> ranking[MarkSheet::kTerms];
+    };
+
+    Group school;
+    std::vector<Group> classes;  // ClassConfig order
+    std::vector<Group> sections; // ClassConfig order
+    double seconds = 0.0;        // Time Compute() took
+
+    // kNoSymbol for the class is the school, for the section the class.
+    const Group* Find(Symbol className, Symbol section) const {
+        if (className == kNoSymbol) return &school;
+        auto it = lookup.find(Key(className, section));
+        if (it == lookup.end()) return nullptr;
+        return section == kNoSymbol ? &classes[it->second] : &sections[it->second];
+    }
+
+    static int GradeOf(int mark) {
+        int g = 0;
+        while (g < kGrades - 1 && mark < kGradeBands[g].minMark) ++g;
+        return g;
+    }
+
+    // Top 10%, Top 25%, Top 50% or Bottom 50% of `ranked` students.
+    static const char* PercentileBand(uint32_t rank, size_t ranked) {
+        double above = ranked ? double(rank - 1) / double(ranked) : 0.0; // Share ranked strictly higher
+        return above < 0.10 ? "Top 10%" : above < 0.25 ? "Top 25%" : above < 0.50 ? "Top 50%" : "Bottom 50%";
+    }
+
+private:
+    friend class MarkAnalytics;
+    static uint64_t Key(Symbol className, Symbol section) { return (uint64_t(className) << 32) | section; }
+    std::unordered_map<uint64_t, size_t> lookup; // Into sections, or classes with section kNoSymbol
+};
+
+// Builds a MarkReport and keeps it until the data changes. Marks are whole
+// numbers 0-100, so every (term, subject) column reduces to a 101-bin count:
+// mean, deviation, percentiles and grades come out of the counts exactly,
+// and class and school figures are the sections' counts added up rather
+// than a second pass over the students.
+//
+// Update() never computes on the calling thread: a change hands snapshots
+// of the roster (copy-on-write), the section index and the config to a
+// background thread, and the previous report stays in use until the new
+// one is ready. Changes made meanwhile collapse into one more computation.
+class MarkAnalytics {
+public:
+    MarkAnalytics() = default;
+
+    ~MarkAnalytics() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (computer.joinable()) computer.join();
+    }
+
+    MarkAnalytics(const MarkAnalytics&) = delete;
+    MarkAnalytics& operator=(const MarkAnalytics&) = delete;
+
+    // The newest finished report; empty until the first one is. Starts a
+    // recomputation if the roster, a mark or the class config changed since
+    // the last one was requested. With wait = true, returns only once the
+    // report is current.
+    const MarkReport& Update(const StudentTable& students, const SectionIndex& index, const ClassConfig& config,
+                             uint64_t rosterVersion, uint64_t marksVersion, bool wait = false) {
+        Versions current{ rosterVersion, marksVersion, config.Generation() };
+        if (!(current == requested)) {
+            Request request{ students, index, config, current };
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                pending = std::move(request); // Replaces one that hasn't started
+            }
+            if (!computer.joinable()) computer = std::thread([this] { ComputeLoop(); });
+            wake.notify_one();
+            requested = current;
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        if (wait) finished.wait(lock, [this] { return shown == requested || (latest && latest->versions == requested); });
+        if (latest) {
+            report = std::move(latest->report);
+            shown = latest->versions;
+            latest.reset();
+        }
+        return report;
+    }
+
+    // Update() is returning an older report while a current one is computed.
+    bool Pending() const { return !(shown == requested); }
+
+    // Update() has returned a finished report at least once.
+    bool Ready() const { return shown.roster != UINT64_MAX; }
+
+    // One pass over the roster in slot order copies every student's marks
+    // into their section's contiguous byte columns, one per (term, subject)
+    // and indexed by roll position; then each section reduces its columns.
+    // Both steps are spread over the WorkerPool's threads, one per core.
+    static MarkReport Compute(const StudentTable& students, const SectionIndex& index, const ClassConfig& config) {
+        PROFILE_SCOPE("MarkAnalytics::Compute");
+        auto start = std::chrono::steady_clock::now();
+
+        MarkReport report;
+        std::vector<Section> sections;
+        static const std::vector<int> kNobody;
+        for (ClassId cls : config.Classes()) {
+            for (SectionId id : config.Sections(cls)) {
+                const SectionIndex::Section* found = index.Find(config.Class(cls).symbol, config.Section(id).symbol);
+                Section& sec = sections.emplace_back();
+                sec.subjects = config.Subjects(id);
+                sec.members = found ? &found->members : &kNobody;
+                sec.cells.assign(MarkSheet::kTerms * sec.subjects.size() * sec.members->size(), kNoCell);
+                MarkReport::Group& group = report.sections.emplace_back();
+                group.className = config.Class(cls).symbol;
+                group.section = config.Section(id).symbol;
+            }
+        }
+
+        // Where each student's marks go; students outside a configured section are skipped
+        const size_t count = students.size();
+        std::vector<uint32_t> sectionOf(count, kNoPlace), positionOf(count);
+        for (size_t s = 0; s < sections.size(); ++s) {
+            const std::vector<int>& members = *sections[s].members;
+            for (size_t i = 0; i < members.size(); ++i) {
+                sectionOf[members[i]] = static_cast<uint32_t>(s);
+                positionOf[members[i]] = static_cast<uint32_t>(i);
+            }
+        }
+        ParallelFor((count + kSlotsPerChunk - 1) / kSlotsPerChunk, count, [&](size_t chunk) {
+            size_t end = std::min(count, (chunk + 1) * kSlotsPerChunk);
+            for (size_t slot = chunk * kSlotsPerChunk; slot < end; ++slot) {
+                if (sectionOf[slot] == kNoPlace) continue;
+                Section& sec = sections[sectionOf[slot]];
+                const MarkSheet& marks = students.Marks()[slot];
+                const size_t n = sec.members->size(), width = sec.subjects.size();
+                uint8_t* cell = sec.cells.data() + positionOf[slot];
+                for (int t = 0; t < MarkSheet::kTerms; ++t) {
+                    for (size_t k = 0; k < width; ++k, cell += n) {
+                        int score = marks.Peek(t + 1, sec.subjects[k], k); // Columns are laid out by subject slot
+                        if (score != MarkSheet::kNoMark) *cell = static_cast<uint8_t>(std::clamp(score, 0, 100));
+                    }
+                }
+            }
+        });
+        ParallelFor(sections.size(), count, [&](size_t s) { ReduceSection(students, sections[s], report.sections[s]); });
+
+        // Classes and the school add up their sections' counts
+        std::vector<SubjectTotals> schoolTotals(MarkSheet::kTerms);
+        size_t next = 0;
+        for (ClassId cls : config.Classes()) {
+            std::vector<SubjectTotals> classTotals(MarkSheet::kTerms);
+            MarkReport::Group& group = report.classes.emplace_back();
+            group.className = config.Class(cls).symbol;
+            for (size_t end = next + config.Sections(cls).size(); next < end; ++next) {
+                const Section& sec = sections[next];
+                for (int t = 0; t < MarkSheet::kTerms; ++t) {
+                    for (size_t k = 0; k < sec.subjects.size(); ++k) {
+                        const Histogram& column = sec.histograms[t * sec.subjects.size() + k];
+                        Add(classTotals[t][sec.subjects[k]], column);
+                        Add(schoolTotals[t][sec.subjects[k]], column);
+                    }
+                }
+                group.students += report.sections[next].students;
+                report.lookup[MarkReport::Key(group.className, report.sections[next].section)] = next;
+            }
+            Finish(classTotals, group);
+            report.school.students += group.students;
+            report.lookup[MarkReport::Key(group.className, kNoSymbol)] = report.classes.size() - 1;
+        }
+        Finish(schoolTotals, report.school);
+
+        report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+
+private:
+    static constexpr size_t kSlotsPerChunk = 4096;  // Also the least work worth a thread of its own
+    static constexpr uint32_t kNoPlace = UINT32_MAX;
+    static constexpr uint8_t kNoCell = 101;         // No mark; counted in the histogram's last bin
+
+    using Histogram = std::array<uint32_t, 102>; // Students per mark 0-100, then unmarked
+    using SubjectTotals = std::unordered_map<Symbol, Histogram>;
+
+    struct Section {
+        Span<Symbol> subjects;
+        const std::vector<int>* members;   // Slots, in roll order
+        std::vector<uint8_t> cells;        // [term][subject][roll position]
+        std::vector<Histogram> histograms; // [term * subjects + subject]
+    };
+
+    struct Versions {
+        uint64_t roster = UINT64_MAX;
+        uint64_t marks = UINT64_MAX;
+        uint64_t config = UINT64_MAX;
+        bool operator==(const Versions& o) const { return roster == o.roster && marks == o.marks && config == o.config; }
+    };
+
+    // What a computation reads, owned by the computing thread.
+    struct Request {
+        StudentTable students; // Shares the roster's columns until it is edited
+        SectionIndex index;
+        ClassConfig config;
+        Versions versions;
+    };
+
+    struct Result {
+        MarkReport report;
+        Versions versions;
+    };
+
+    // Runs fn(0) .. fn(tasks - 1) on the shared WorkerPool, using fewer of
+    // its threads when `work` (students touched) is too little to pay for them.
+    template <typename Fn>
+    static void ParallelFor(size_t tasks, size_t work, Fn&& fn) {
+        unsigned threadCount = std::max(1u, std::min<unsigned>({ WorkerPool::Get().Size(),
+                                                                 static_cast<unsigned>(tasks),
+                                                                 static_cast<unsigned>(work / kSlotsPerChunk + 1) }));
+        WorkerPool::Get().ParallelFor(tasks, threadCount, fn);
+    }
+
+    void ComputeLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || pending; });
+            if (stopping) return;
+            Request request = std::move(*pending);
+            pending.reset();
+            lock.unlock();
+            Result result{ Compute(request.students, request.index, request.config), request.versions };
+            lock.lock();
+            latest = std::move(result);
+            finished.notify_all();
+        }
+    }
+
+    // Each column in a straight pass: its histogram, and every member's
+    // running term total. Then members are ranked by term average.
+    static void ReduceSection(const StudentTable& students, Section& sec, MarkReport::Group& out) {
+        const size_t n = sec.members->size(), width = sec.subjects.size();
+        out.students = static_cast<uint32_t>(n);
+        sec.histograms.assign(MarkSheet::kTerms * width, Histogram{});
+        std::vector<uint32_t> sums(n);
+        std::vector<uint16_t> counts(n);
+        std::vector<uint64_t> keys, buffer;
+        for (int t = 0; t < MarkSheet::kTerms; ++t) {
+            std::fill(sums.begin(), sums.end(), 0);
+            std::fill(counts.begin(), counts.end(), 0);
+            out.subjects[t].resize(width);
+            for (size_t k = 0; k < width; ++k) {
+                const uint8_t* column = sec.cells.data() + (t * width + k) * n;
+                Histogram& histogram = sec.histograms[t * width + k];
+                for (size_t i = 0; i < n; ++i) ++histogram[column[i]];
+                for (size_t i = 0; i < n; ++i) {
+                    bool marked = column[i] != kNoCell;
+                    sums[i] += marked ? column[i] : 0;
+                    counts[i] += marked;
+                }
+                out.subjects[t][k] = Summarize(sec.subjects[k], histogram);
+            }
+
+            // Competition ranking ("1, 2, 2, 4") by term average, equal
+            // averages in roll order. A positive float's bits sort like the
+            // float, so each student gets one 64-bit key, (average desc,
+            // roll position), and a radix sort orders them.
+            keys.clear();
+            for (size_t i = 0; i < n; ++i) {
+                if (!counts[i]) continue;
+                float average = float(sums[i]) / counts[i];
+                uint32_t bits;
+                std::memcpy(&bits, &average, sizeof bits);
+                keys.push_back(uint64_t(~bits) << 32 | i);
+            }
+            SortByHighWord(keys, buffer);
+            std::vector<MarkReport::RankedStudent>& ranking = out.ranking[t];
+            ranking.resize(keys.size());
+            for (size_t r = 0; r < keys.size(); ++r) {
+                size_t i = static_cast<uint32_t>(keys[r]);
+                float average = float(sums[i]) / counts[i];
+                bool tied = r > 0 && average == ranking[r - 1].average;
+                ranking[r] = { students.Ids()[(*sec.members)[i]], average, tied ? ranking[r - 1].rank : static_cast<uint32_t>(r + 1) };
+            }
+        }
+        sec.cells = {};
+    }
+
+    // Stable LSD radix sort on the upper 32 bits, a byte per pass; a pass
+    // is skipped when every key has the same byte (the exponent bytes of
+    // averages in the same range).
+    static void SortByHighWord(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer) {
+        buffer.resize(keys.size());
+        for (int shift = 32; shift < 64; shift += 8) {
+            size_t offsets[257] = {};
+            for (uint64_t k : keys) ++offsets[((k >> shift) & 0xFF) + 1];
+            if (std::find(offsets + 1, offsets + 257, keys.size()) != offsets + 257) continue;
+            for (int b = 0; b < 256; ++b) offsets[b + 1] += offsets[b];
+            for (uint64_t k : keys) buffer[offsets[(k >> shift) & 0xFF]++] = k;
+            keys.swap(buffer);
+        }
+    }
+
+    static void Add(Histogram& into, const Histogram& from) {
+        for (size_t m = 0; m < into.size(); ++m) into[m] += from[m];
+    }
+
+    // Subjects by name, each summarized from its summed counts.
+    static void Finish(const std::vector<SubjectTotals>& totals, MarkReport::Group& out) {
+        const SymbolTable& symbols = SymbolTable::Get();
+        for (int t = 0; t < MarkSheet::kTerms; ++t) {
+            for (const auto& [subject, histogram] : totals[t]) out.subjects[t].push_back(Summarize(subject, histogram));
+            std::sort(out.subjects[t].begin(), out.subjects[t].end(),
+                      [&symbols](const MarkReport::SubjectStats& a, const MarkReport::SubjectStats& b) {
+                          return symbols.Str(a.subject) < symbols.Str(b.subject);
+                      });
+        }
+    }
+
+    static MarkReport::SubjectStats Summarize(Symbol subject, const Histogram& histogram) {
+        MarkReport::SubjectStats s;
+        s.subject = subject;
+        uint64_t sum = 0, sumSquares = 0;
+        for (int m = 0; m <= 100; ++m) {
+            uint64_t c = histogram[m];
+            s.count += static_cast<uint32_t>(c);
+            sum += c * m;
+            sumSquares += c * m * m;
+            s.grades[MarkReport::GradeOf(m)] += static_cast<uint32_t>(c);
+        }
+        if (s.count == 0) return s;
+
+        double mean = double(sum) / s.count;
+        s.mean = static_cast<float>(mean);
+        s.stddev = static_cast<float>(std::sqrt(std::max(0.0, double(sumSquares) / s.count - mean * mean)));
+        // Nearest rank: the lowest mark with at least ceil(p * count) students at or below it
+        auto percentile = [&histogram, &s](double p) {
+            uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * s.count)));
+            uint64_t seen = 0;
+            for (int m = 0; m <= 100; ++m)
+                if ((seen += histogram[m]) >= target) return static_cast<uint8_t>(m);
+            return uint8_t(100);
+        };
+        s.min = percentile(0.0);
+        s.p25 = percentile(0.25);
+        s.median = percentile(0.50);
+        s.p75 = percentile(0.75);
+        s.p90 = percentile(0.90);
+        s.max = percentile(1.0);
+        return s;
+    }
+
+    // Calling thread only
+    MarkReport report;
+    Versions shown;     // Of report
+    Versions requested; // Of the newest request
+
+    std::mutex mutex; // Guards everything below
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::optional<Request> pending;
+    std::optional<Result> latest; // Finished, not yet picked up
+    bool stopping = false;
+    std::thread computer; // Started by the first Update()
+};
@@ -0,0 +1,285 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Named scoped timers for finding where a slow frame went. PROFILE_SCOPE
+// costs one relaxed atomic load while the profiler is off (the default);
+// building with EDUSAVANT_NO_PROFILER removes the scopes entirely. While on,
+// each scope adds its duration to a per-frame breakdown shown by the
+// profiler overlay, and while a trace is recording it is also kept as an
+// event for Profiler::WriteTrace() (Chrome trace format, open it in
+// chrome://tracing or ui.perfetto.dev). Scopes may run on any thread.
+//
+// Scope names must be string literals: they are stored by pointer.
+class Profiler {
+public:
+    static Profiler& Get() {
+        static Profiler instance;
+        return instance;
+    }
+
+    static bool Enabled() { return enabled.load(std::memory_order_relaxed); }
+    void SetEnabled(bool on) { enabled.store(on || Tracing(), std::memory_order_relaxed); }
+
+    static uint64_t NowNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Small per-thread number for the breakdown and the trace; the thread
+    // that calls BeginFrame() is the UI thread.
+    static int ThreadId() {
+        static std::atomic<int> next{0};
+        thread_local int id = next.fetch_add(1);
+        return id;
+    }
+
+    void Record(const char* name, uint64_t startNs, uint64_t endNs) {
+        int thread = ThreadId();
+        std::lock_guard<std::mutex> lock(mutex);
+        Scope& s = scopes[Key{ name, thread }];
+        s.frameNs += endNs - startNs;
+        ++s.frameCalls;
+        if (tracing) {
+            if (events.size() < kMaxTraceEvents) events.push_back({ name, thread, startNs, endNs - startNs });
+            else ++droppedEvents;
+        }
+    }
+
+    // Counters for the overlay. Cheap no-ops while disabled.
+    static void CountAllocation(size_t bytes) {
+        if (!Enabled()) return;
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    static void CountBytesWritten(size_t bytes) {
+        if (!Enabled()) return;
+        bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    // Bracket the work of one frame (not the wait before it) on the UI thread.
+    void BeginFrame() {
+        uiThread = ThreadId();
+        frameStart = NowNs();
+        frameAllocations = allocations.load(std::memory_order_relaxed);
+        frameAllocatedBytes = allocatedBytes.load(std::memory_order_relaxed);
+        frameBytesWritten = bytesWritten.load(std::memory_order_relaxed);
+    }
+
+    void EndFrame() {
+        if (!Enabled()) return;
+        Frame f;
+        f.ms = float((NowNs() - frameStart) / 1e6);
+        f.allocations = allocations.load(std::memory_order_relaxed) - frameAllocations;
+        f.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed) - frameAllocatedBytes;
+        f.bytesWritten = bytesWritten.load(std::memory_order_relaxed) - frameBytesWritten;
+        lastFrame = f;
+        frameHistory[historyNext] = f.ms;
+        historyNext = (historyNext + 1) % kHistory;
+        historyCount = std::min(historyCount + 1, kHistory);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [key, s] : scopes) {
+            double ms = s.frameNs / 1e6;
+            s.lastMs = ms;
+            s.lastCalls = s.frameCalls;
+            s.avgMs = s.avgMs * (1.0 - kSmoothing) + ms * kSmoothing;
+            s.peakMs = std::max(s.peakMs, ms);
+            s.frameNs = 0;
+            s.frameCalls = 0;
+        }
+    }
+
+    struct Frame {
+        float ms = 0.0f;
+        size_t allocations = 0;
+        size_t allocatedBytes = 0;
+        size_t bytesWritten = 0;
+    };
+    const Frame& LastFrame() const { return lastFrame; }
+    size_t TotalBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+
+    // Frame times in ms, oldest first, for ImGui::PlotLines.
+    std::vector<float> FrameHistory() const {
+        std::vector<float> out;
+        out.reserve(historyCount);
+        for (size_t i = 0; i < historyCount; ++i)
+            out.push_back(frameHistory[(historyNext + kHistory - historyCount + i) % kHistory]);
+        return out;
+    }
+
+    struct ScopeStats {
+        const char* name;
+        bool uiThread;
+        int thread;
+        uint32_t calls; // In the last frame
+        double lastMs, avgMs, peakMs;
+    };
+
+    // Every scope seen so far, slowest (smoothed) first.
+    std::vector<ScopeStats> Scopes() const {
+        std::vector<ScopeStats> out;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            out.reserve(scopes.size());
+            for (const auto& [key, s] : scopes)
+                out.push_back({ key.name, key.thread == uiThread, key.thread, s.lastCalls, s.lastMs, s.avgMs, s.peakMs });
+        }
+        std::sort(out.begin(), out.end(), [](const ScopeStats& a, const ScopeStats& b) { return a.avgMs > b.avgMs; });
+        return out;
+    }
+
+    void ResetPeaks() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [key, s] : scopes) s.peakMs = 0.0;
+    }
+
+    // --- Chrome trace ---
+    bool Tracing() const { return tracing.load(std::memory_order_relaxed); }
+    size_t TraceEventCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events.size();
+    }
+
+    void StartTrace() {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.clear();
+        droppedEvents = 0;
+        traceStart = NowNs();
+        tracing = true;
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    struct Event {
+        const char* name;
+        int thread;
+        uint64_t startNs;
+        uint64_t durationNs;
+    };
+
+    // A stopped recording, ready for WriteTrace().
+    struct Trace {
+        std::vector<Event> events;
+        uint64_t startNs = 0;
+        int uiThread = 0;
+        size_t dropped = 0; // Events past kMaxTraceEvents
+    };
+
+    // Stops recording and hands over the events. Cheap; call it on the UI
+    // thread and write the result elsewhere. Leaves the profiler enabled;
+    // the overlay decides that.
+    Trace StopTrace() {
+        Trace trace;
+        std::lock_guard<std::mutex> lock(mutex);
+        tracing = false;
+        trace.events.swap(events);
+        trace.startNs = traceStart;
+        trace.uiThread = uiThread;
+        trace.dropped = droppedEvents;
+        return trace;
+    }
+
+    // Writes a stopped trace to `path`; false if it can't be written. Touches
+    // no profiler state, so it may run on any thread.
+    static bool WriteTrace(const Trace& trace, const std::string& path) {
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"UI\"}}", trace.uiThread);
+        for (const Event& e : trace.events) {
+            std::fprintf(file, ",\n{\"name\":\"");
+            for (const char* c = e.name; *c; ++c) {
+                if (*c == '"' || *c == '\\') std::fputc('\\', file);
+                std::fputc(*c, file);
+            }
+            std::fprintf(file, "\",\"cat\":\"EduSavant\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                         e.thread, int64_t(e.startNs - trace.startNs) / 1e3, e.durationNs / 1e3); // Scopes may predate the trace
+        }
+        std::fprintf(file, "\n]}\n");
+        bool ok = std::ferror(file) == 0;
+        ok = std::fclose(file) == 0 && ok;
+        return ok;
+    }
+
+    size_t DroppedTraceEvents() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return droppedEvents;
+    }
+
+    static constexpr size_t kHistory = 240;              // Frames in the graph
+    static constexpr size_t kMaxTraceEvents = 1u << 20; // ~32 MB; later events are dropped
+
+private:
+    static constexpr double kSmoothing = 0.05; // Weight of the newest frame in avgMs
+
+    Profiler() = default;
+
+    struct Key {
+        const char* name;
+        int thread;
+        bool operator==(const Key& o) const { return name == o.name && thread == o.thread; }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& k) const { return std::hash<const void*>()(k.name) ^ (size_t(k.thread) << 1); }
+    };
+    struct Scope {
+        uint64_t frameNs = 0; // Accumulating for the current frame
+        uint32_t frameCalls = 0;
+        uint32_t lastCalls = 0;
+        double lastMs = 0.0, avgMs = 0.0, peakMs = 0.0;
+    };
+
+    static inline std::atomic<bool> enabled{false};
+    static inline std::atomic<size_t> allocations{0};
+    static inline std::atomic<size_t> allocatedBytes{0};
+    static inline std::atomic<size_t> bytesWritten{0};
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Scope, KeyHash> scopes;
+    std::vector<Event> events;
+    size_t droppedEvents = 0;
+    std::atomic<bool> tracing{false};
+    uint64_t traceStart = 0;
+
+    // UI thread only
+    int uiThread = 0;
+    uint64_t frameStart = 0;
+    size_t frameAllocations = 0, frameAllocatedBytes = 0, frameBytesWritten = 0;
+    Frame lastFrame;
+    float frameHistory[kHistory] = {};
+    size_t historyNext = 0;
+    size_t historyCount = 0;
+};
+
+// Times the enclosing block under `name` while the profiler is enabled.
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(Profiler::Enabled() ? name : nullptr), start(this->name ? Profiler::NowNs() : 0) {}
+    ~ProfileScope() {
+        if (name) Profiler::Get().Record(name, start, Profiler::NowNs());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#ifdef EDUSAVANT_NO_PROFILER
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#endif
@@ -0,0 +1,90 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Models/ClassConfig.h"
+
+// End-of-year promotion: which class every class moves up to and where its
+// sections land. DataManager::Promote applies a plan to the whole roster in
+// one pass; students of a graduating class go to an archive file instead.
+struct PromotionPlan {
+    struct Step {
+        std::string fromClass;
+        std::string toClass; // Empty: the class graduates
+        std::vector<std::pair<std::string, std::string>> sections; // From section -> to section
+    };
+    std::vector<Step> steps;
+    bool resetRecords = false; // Promoted students start the year with no marks and 0% attendance
+
+    // Every configured class moves to the next one in natural order ("2"
+    // before "10"; names that aren't numbers sort after, alphabetically) and
+    // the last class graduates. A section keeps its name if the next class
+    // has it, else it goes to the next class's first section.
+    static PromotionPlan Default(const ClassConfig& config) {
+        std::vector<ClassId> classes(config.Classes().begin(), config.Classes().end());
+        std::sort(classes.begin(), classes.end(),
+                  [&config](ClassId a, ClassId b) { return NaturalLess(config.Class(a).name, config.Class(b).name); });
+
+        PromotionPlan plan;
+        for (size_t i = 0; i < classes.size(); ++i) {
+            Step step;
+            step.fromClass = config.Class(classes[i]).name;
+            if (i + 1 < classes.size()) {
+                ClassId next = classes[i + 1];
+                step.toClass = config.Class(next).name;
+                Span<SectionId> targets = config.Sections(next);
+                for (SectionId sec : config.Sections(classes[i])) {
+                    const ClassConfig::SectionEntry& from = config.Section(sec);
+                    bool same = config.FindSection(next, from.symbol) != kNoSection;
+                    if (same || !targets.empty())
+                        step.sections.emplace_back(from.name, same ? from.name : config.Section(targets.front()).name);
+                }
+            }
+            plan.steps.push_back(std::move(step));
+        }
+        return plan;
+    }
+
+    // Reasons the plan can't be applied; empty if it can.
+    std::vector<std::string> Problems(const ClassConfig& config) const {
+        std::vector<std::string> problems;
+        for (const Step& step : steps) {
+            if (step.toClass.empty()) continue;
+            ClassId target = config.FindClass(step.toClass);
+            if (target == kNoClass) {
+                problems.push_back("class " + step.toClass + " is not configured");
+            } else if (config.Sections(target).empty()) {
+                problems.push_back("class " + step.toClass + " has no sections to promote " + step.fromClass + " into");
+            } else {
+                for (const auto& [from, to] : step.sections)
+                    if (config.FindSection(target, to) == kNoSection)
+                        problems.push_back("class " + step.toClass + " has no section \"" + to + "\"");
+            }
+        }
+        return problems;
+    }
+
+    // "archive/graduates-<label>.db"; the label defaults to the current year.
+    static std::string ArchivePath(std::string label = {}) {
+        if (label.empty()) {
+            std::time_t now = std::time(nullptr);
+            label = std::to_string(1900 + std::localtime(&now)->tm_year);
+        }
+        return "archive/graduates-" + label + ".db";
+    }
+
+    static bool NaturalLess(const std::string& a, const std::string& b) {
+        auto number = [](const std::string& s) {
+            bool digits = !s.empty() && s.size() < 10 &&
+                          std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); });
+            return digits ? std::stol(s) : -1L;
+        };
+        long x = number(a), y = number(b);
+        if ((x < 0) != (y < 0)) return x >= 0; // Numbers first
+        if (x >= 0 && x != y) return x < y;
+        return a < b;
+    }
+};
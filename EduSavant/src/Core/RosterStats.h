@@ -0,0 +1,142 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <unordered_map>
+#include <vector>
+#include "Core/SymbolTable.h"
+#include "Models/StudentTable.h"
+
+// Dashboard aggregates kept current as the roster changes: totals, attendance
+// mean/min/max, per-class and per-section counts and mean attendance, and
+// per-term subject means. DataManager feeds every add, delete, attendance,
+// class/section and mark change through here, so reading any figure costs
+// the same no matter how many students there are. Rebuild() is for loads.
+// Subject means are kept as a ready-made subject-by-term table in name
+// order, so the dashboard draws it without building anything per frame.
+class RosterStats {
+public:
+    struct Group {
+        uint32_t count = 0;
+        double attendanceSum = 0.0;
+        double MeanAttendance() const { return count ? attendanceSum / count : 0.0; }
+    };
+
+    struct Score {
+        uint32_t count = 0;
+        double sum = 0.0;
+        double Mean() const { return count ? sum / count : 0.0; }
+    };
+
+    struct SubjectRow {
+        Symbol subject = kNoSymbol;
+        Score terms[MarkSheet::kTerms]; // Term 1 first
+        bool Empty() const {
+            return std::none_of(std::begin(terms), std::end(terms), [](const Score& s) { return s.count > 0; });
+        }
+    };
+
+    void Rebuild(const StudentTable& students) {
+        Clear();
+        for (int slot = 0; slot < static_cast<int>(students.size()); ++slot) {
+            AddStudent(students, slot);
+            AddMarks(students.Marks()[slot]);
+        }
+    }
+
+    void Clear() {
+        total = Group{};
+        attendanceValues.clear();
+        classes.clear();
+        sections.clear();
+        subjects.clear();
+        subjectRow.clear();
+    }
+
+    // Attendance and class/section membership of one row.
+    void AddStudent(const StudentTable& students, int slot) { Apply(students, slot, +1); }
+    void RemoveStudent(const StudentTable& students, int slot) { Apply(students, slot, -1); }
+
+    void AddMarks(const MarkSheet& marks) {
+        marks.ForEach([this](int term, Symbol subject, int score) { ChangeMark(term, subject, MarkSheet::kNoMark, score); });
+    }
+    void RemoveMarks(const MarkSheet& marks) {
+        marks.ForEach([this](int term, Symbol subject, int score) { ChangeMark(term, subject, score, MarkSheet::kNoMark); });
+    }
+
+    // Either side may be MarkSheet::kNoMark (mark added or removed). Terms
+    // outside 1..kTerms are ignored.
+    void ChangeMark(int term, Symbol subject, int before, int after) {
+        if (term < 1 || term > MarkSheet::kTerms) return;
+        Score& s = subjects[RowOf(subject)].terms[term - 1];
+        if (before != MarkSheet::kNoMark) { --s.count; s.sum -= before; }
+        if (after != MarkSheet::kNoMark) { ++s.count; s.sum += after; }
+    }
+
+    size_t Count() const { return total.count; }
+    double MeanAttendance() const { return total.MeanAttendance(); }
+    float MinAttendance() const { return attendanceValues.empty() ? 0.0f : attendanceValues.begin()->first; }
+    float MaxAttendance() const { return attendanceValues.empty() ? 0.0f : attendanceValues.rbegin()->first; }
+
+    // Empty groups (count 0) are left in place; callers skip them.
+    const std::unordered_map<Symbol, Group>& Classes() const { return classes; }
+
+    Group Section(Symbol className, Symbol section) const {
+        auto it = sections.find(SectionKey(className, section));
+        return it == sections.end() ? Group{} : it->second;
+    }
+
+    Score Subject(int term, Symbol subject) const {
+        auto it = subjectRow.find(subject);
+        if (it == subjectRow.end() || term < 1 || term > MarkSheet::kTerms) return Score{};
+        return subjects[it->second].terms[term - 1];
+    }
+
+    // Every subject that has had a mark, by name. Rows whose marks have all
+    // been removed are left in place (Empty()); callers skip them.
+    const std::vector<SubjectRow>& Subjects() const { return subjects; }
+
+private:
+    static uint64_t SectionKey(Symbol className, Symbol section) { return (uint64_t(className) << 32) | section; }
+
+    // The subject's row, inserted in name order the first time it is seen.
+    size_t RowOf(Symbol subject) {
+        auto it = subjectRow.find(subject);
+        if (it != subjectRow.end()) return it->second;
+        const SymbolTable& symbols = SymbolTable::Get();
+        auto pos = std::lower_bound(subjects.begin(), subjects.end(), symbols.View(subject),
+                                    [&symbols](const SubjectRow& row, std::string_view name) {
+                                        return symbols.View(row.subject) < name;
+                                    });
+        size_t row = static_cast<size_t>(pos - subjects.begin());
+        subjects.insert(pos, SubjectRow{ subject, {} });
+        for (size_t i = row; i < subjects.size(); ++i) subjectRow[subjects[i].subject] = i; // Later rows moved down
+        return row;
+    }
+
+    void Apply(const StudentTable& students, int slot, int sign) {
+        float attendance = students.Attendance()[slot];
+        Symbol cls = students.ClassNames()[slot];
+        Symbol sec = students.Sections()[slot];
+        for (Group* g : { &total, &classes[cls], &sections[SectionKey(cls, sec)] }) {
+            g->count += sign;
+            g->attendanceSum += sign * double(attendance);
+        }
+        // Min/max come from a value -> count map: O(log distinct values)
+        if (sign > 0) {
+            ++attendanceValues[attendance];
+        } else {
+            auto it = attendanceValues.find(attendance);
+            if (it != attendanceValues.end() && --it->second == 0) attendanceValues.erase(it);
+        }
+        if (total.count == 0) total.attendanceSum = 0.0; // Don't let rounding drift outlive the data
+    }
+
+    Group total;
+    std::map<float, uint32_t> attendanceValues;
+    std::unordered_map<Symbol, Group> classes;
+    std::unordered_map<uint64_t, Group> sections; // SectionKey -> group
+    std::vector<SubjectRow> subjects;             // By subject name
+    std::unordered_map<Symbol, size_t> subjectRow; // Subject -> index into subjects
+};
@@ -0,0 +1,214 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Core/IdIndex.h"
+
+// Case-insensitive substring and typo-tolerant search over a few text fields
+// per record, keyed by record ID. Each record's fields are case-folded and
+// broken into trigrams; a posting list per trigram names the records that
+// contain it. A query intersects the lists of its own trigrams, so it only
+// looks at records that share text with it instead of scanning them all.
+//
+// Results are ranked: a prefix match on the first field, then substring
+// matches by field order, then fuzzy matches (most shared trigrams first).
+// Queries shorter than a trigram fall back to a scan of the folded text.
+// Not thread-safe; Search() reuses scratch buffers.
+class SearchIndex {
+public:
+    static constexpr int kMaxFields = 4;
+
+    // Indexes (or re-indexes) a record. Fields are given in ranking order.
+    void Put(int id, std::initializer_list<std::string_view> fields) {
+        Remove(id);
+        Doc doc;
+        doc.id = id;
+        size_t length = fields.size();
+        for (std::string_view field : fields) length += field.size();
+        doc.text.reserve(length);
+        int f = 0;
+        for (std::string_view field : fields) {
+            if (f == kMaxFields) break;
+            if (f > 0) doc.text.push_back(kSeparator);
+            for (char c : field) doc.text.push_back(Fold(c));
+            doc.ends[f++] = static_cast<uint32_t>(doc.text.size());
+        }
+        for (; f < kMaxFields; ++f) doc.ends[f] = static_cast<uint32_t>(doc.text.size());
+
+        uint32_t docId = static_cast<uint32_t>(docs.size());
+        docs.push_back(std::move(doc));
+        docOf.Insert(id, static_cast<int>(docId));
+        AddPostings(docId);
+    }
+
+    void Remove(int id) {
+        int docId = docOf.Find(id);
+        if (docId == IdIndex::kNotFound) return;
+        docOf.Erase(id);
+        docs[docId].alive = false;
+        docs[docId].text = std::string();
+        // Postings of dead docs are skipped at query time and dropped in bulk
+        if (++dead > 1024 && dead > docOf.Size()) Compact();
+    }
+
+    void Clear() {
+        docs.clear();
+        postings.clear();
+        docOf.Clear();
+        dead = 0;
+    }
+
+    size_t Size() const { return docOf.Size(); }
+
+    // For bulk loads: room for n more records without rehashing.
+    void Reserve(size_t n) {
+        docs.reserve(docs.size() + n);
+        docOf.Reserve(docOf.Size() + n);
+    }
+
+    // Record IDs matching the query, best first. An empty query matches nothing.
+    std::vector<int> Search(std::string_view query) const {
+        std::string q;
+        for (char c : query) q.push_back(Fold(c));
+        std::vector<int> ids;
+        if (q.empty()) return ids;
+
+        std::vector<std::pair<uint8_t, uint32_t>> hits; // (rank, docId)
+        if (q.size() < 3) {
+            for (uint32_t d = 0; d < docs.size(); ++d) {
+                if (!docs[d].alive) continue;
+                int rank = ExactRank(docs[d], q);
+                if (rank >= 0) hits.push_back({ uint8_t(rank), d });
+            }
+        } else {
+            std::vector<uint32_t> grams = Trigrams(q);
+            int total = static_cast<int>(grams.size());
+            // One typo breaks up to three trigrams. Allow one per eight characters
+            // (at least one), but always require half of the query's trigrams.
+            int edits = 1 + static_cast<int>(q.size()) / 8;
+            int need = std::max({ 1, total - 3 * edits, (total + 1) / 2 });
+
+            // Rarest lists first. A doc absent from the first (total - need + 1)
+            // lists can't reach `need`, so only those lists are scanned; the
+            // longer ones are probed (binary search) for the candidates found.
+            std::vector<const std::vector<uint32_t>*> lists;
+            for (uint32_t g : grams) {
+                auto it = postings.find(g);
+                if (it != postings.end()) lists.push_back(&it->second);
+            }
+            std::sort(lists.begin(), lists.end(), [](auto* a, auto* b) { return a->size() < b->size(); });
+            size_t scanned = std::min(lists.size(), static_cast<size_t>(total - need + 1));
+
+            counts.resize(docs.size());
+            touched.clear();
+            for (size_t i = 0; i < scanned; ++i) {
+                for (uint32_t d : *lists[i]) {
+                    if (counts[d]++ == 0) touched.push_back(d);
+                }
+            }
+            for (size_t i = scanned; i < lists.size(); ++i) {
+                for (uint32_t d : touched) {
+                    if (std::binary_search(lists[i]->begin(), lists[i]->end(), d)) ++counts[d];
+                }
+            }
+            for (uint32_t d : touched) {
+                int shared = counts[d];
+                counts[d] = 0;
+                if (!docs[d].alive || shared < need) continue;
+                int rank = shared == total ? ExactRank(docs[d], q) : -1;
+                if (rank < 0) rank = kFuzzyRank + std::min(total - shared, 255 - kFuzzyRank);
+                hits.push_back({ uint8_t(rank), d });
+            }
+        }
+
+        // Ranks are small integers: a counting sort keeps this linear
+        size_t bucket[257] = {};
+        for (const auto& h : hits) ++bucket[h.first + 1];
+        for (int r = 1; r < 257; ++r) bucket[r] += bucket[r - 1];
+        ids.resize(hits.size());
+        for (const auto& h : hits) ids[bucket[h.first]++] = docs[h.second].id;
+        return ids;
+    }
+
+private:
+    static constexpr char kSeparator = '\x1f'; // Never folded from input, so matches can't span fields
+    static constexpr int kFuzzyRank = 1 + kMaxFields;
+
+    struct Doc {
+        int id = 0;
+        bool alive = true;
+        std::string text;            // Folded fields joined by kSeparator
+        uint32_t ends[kMaxFields]{}; // End offset of each field in text
+    };
+
+    static char Fold(char c) {
+        if (c >= 'A' && c <= 'Z') return static_cast<char>(c - 'A' + 'a');
+        return c == kSeparator ? ' ' : c;
+    }
+
+    static uint32_t Gram(const char* p) {
+        return uint32_t(uint8_t(p[0])) | uint32_t(uint8_t(p[1])) << 8 | uint32_t(uint8_t(p[2])) << 16;
+    }
+
+    // Distinct trigrams of a folded string, not spanning field separators.
+    static std::vector<uint32_t> Trigrams(std::string_view s) {
+        std::vector<uint32_t> grams;
+        grams.reserve(s.size());
+        for (size_t i = 0; i + 3 <= s.size(); ++i) {
+            if (s[i] == kSeparator || s[i + 1] == kSeparator || s[i + 2] == kSeparator) continue;
+            grams.push_back(Gram(s.data() + i));
+        }
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        return grams;
+    }
+
+    // 0 = prefix of the first field, 1 + f = substring of field f, -1 = none.
+    static int ExactRank(const Doc& doc, std::string_view q) {
+        size_t pos = std::string_view(doc.text).find(q);
+        if (pos == std::string_view::npos) return -1;
+        if (pos == 0) return 0;
+        int f = 0;
+        while (f + 1 < kMaxFields && pos >= doc.ends[f]) ++f;
+        return 1 + f;
+    }
+
+    // docIds only grow between compactions, so every list stays sorted, and
+    // a trigram repeated within the doc is caught by checking the list's tail.
+    void AddPostings(uint32_t docId) {
+        const std::string& s = docs[docId].text;
+        for (size_t i = 0; i + 3 <= s.size(); ++i) {
+            if (s[i] == kSeparator || s[i + 1] == kSeparator || s[i + 2] == kSeparator) continue;
+            std::vector<uint32_t>& list = postings[Gram(s.data() + i)];
+            if (list.empty() || list.back() != docId) list.push_back(docId);
+        }
+    }
+
+    // Renumbers the live docs densely and rebuilds every posting list.
+    void Compact() {
+        std::vector<Doc> live;
+        live.reserve(docOf.Size());
+        for (Doc& d : docs)
+            if (d.alive) live.push_back(std::move(d));
+        docs = std::move(live);
+        postings.clear();
+        docOf.Clear();
+        for (uint32_t d = 0; d < docs.size(); ++d) {
+            docOf.Insert(docs[d].id, static_cast<int>(d));
+            AddPostings(d);
+        }
+        dead = 0;
+    }
+
+    std::vector<Doc> docs;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> postings; // Trigram -> docIds, ascending
+    IdIndex docOf;                                                // Record ID -> docId
+    size_t dead = 0;
+
+    mutable std::vector<uint16_t> counts; // Per-doc shared trigram counts, zero between queries
+    mutable std::vector<uint32_t> touched;
+};
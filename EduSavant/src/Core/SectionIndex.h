@@ -0,0 +1,145 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Core/SymbolTable.h"
+#include "Models/StudentTable.h"
+
+// Students grouped by class-section, each group kept in roll order
+// (name, then ID) as a list of slots into the StudentTable. Roll numbers
+// are the 1-based position in that list, so inserting, removing or renaming
+// one student only renumbers the tail of its own section.
+class SectionIndex {
+public:
+    struct Section {
+        Symbol className = kEmptySymbol;
+        Symbol section = kEmptySymbol;
+        std::vector<int> members; // Slots, in roll order
+        bool touched = false;     // Changed in an open batch; members are stale
+    };
+
+    // Regroups and renumbers the whole roster.
+    void Rebuild(StudentTable& students) {
+        for (auto& sec : sections) sec.members.clear();
+        for (int slot = 0; slot < static_cast<int>(students.size()); ++slot)
+            GetOrAdd(students, slot).members.push_back(slot);
+        for (auto& sec : sections) {
+            std::sort(sec.members.begin(), sec.members.end(), RollOrder{ students });
+            Renumber(students, sec, 0);
+            sec.touched = false;
+        }
+        touchedCount = 0;
+    }
+
+    void Insert(StudentTable& students, int slot) {
+        Section& sec = GetOrAdd(students, slot);
+        auto pos = std::lower_bound(sec.members.begin(), sec.members.end(), slot, RollOrder{ students });
+        size_t from = pos - sec.members.begin();
+        sec.members.insert(pos, slot);
+        Renumber(students, sec, from);
+    }
+
+    // Call while students[slot] still holds the values it was inserted with.
+    void Remove(StudentTable& students, int slot) {
+        Section& sec = GetOrAdd(students, slot);
+        auto pos = std::lower_bound(sec.members.begin(), sec.members.end(), slot, RollOrder{ students });
+        if (pos == sec.members.end() || *pos != slot) return;
+        size_t from = pos - sec.members.begin();
+        sec.members.erase(pos);
+        Renumber(students, sec, from);
+    }
+
+    // The student at `from` is about to move to slot `to` (swap-and-pop).
+    // Call before the move, while students[from] is still valid.
+    void Relocate(const StudentTable& students, int from, int to) {
+        Section& sec = GetOrAdd(students, from);
+        if (sec.touched) return; // Its list is rebuilt by RegroupTouched() anyway
+        auto pos = std::lower_bound(sec.members.begin(), sec.members.end(), from, RollOrder{ students });
+        if (pos != sec.members.end() && *pos == from) *pos = to;
+    }
+
+    // Batched changes: Touch() the section of a student before and after
+    // changing it instead of Remove()/Insert(). A touched section's list is
+    // stale until RegroupTouched() refills it from one pass over the roster
+    // and renumbers it.
+    void Touch(const StudentTable& students, int slot) {
+        Section& sec = GetOrAdd(students, slot);
+        if (!sec.touched) ++touchedCount;
+        sec.touched = true;
+    }
+
+    // Returns whether any section was touched.
+    bool RegroupTouched(StudentTable& students) {
+        if (touchedCount == 0) return false;
+        for (auto& sec : sections)
+            if (sec.touched) sec.members.clear();
+        for (int slot = 0; slot < static_cast<int>(students.size()); ++slot) {
+            Section& sec = GetOrAdd(students, slot);
+            if (sec.touched) sec.members.push_back(slot);
+        }
+        for (auto& sec : sections) {
+            if (!sec.touched) continue;
+            std::sort(sec.members.begin(), sec.members.end(), RollOrder{ students });
+            Renumber(students, sec, 0);
+            sec.touched = false;
+        }
+        touchedCount = 0;
+        return true;
+    }
+
+    const Section* Find(Symbol className, Symbol section) const {
+        auto it = lookup.find(Key(className, section));
+        return it == lookup.end() ? nullptr : &sections[it->second];
+    }
+
+    // All sections ordered by class name, then section name.
+    std::vector<const Section*> InOrder() const {
+        std::vector<const Section*> out;
+        out.reserve(sections.size());
+        for (const auto& sec : sections) out.push_back(&sec);
+        const SymbolTable& symbols = SymbolTable::Get();
+        std::sort(out.begin(), out.end(), [&symbols](const Section* a, const Section* b) {
+            if (a->className != b->className) return symbols.Str(a->className) < symbols.Str(b->className);
+            return symbols.Str(a->section) < symbols.Str(b->section);
+        });
+        return out;
+    }
+
+    void Clear() {
+        sections.clear();
+        lookup.clear();
+        touchedCount = 0;
+    }
+
+private:
+    struct RollOrder {
+        const StudentTable& students;
+        bool operator()(int a, int b) const {
+            int order = students.Names()[a].compare(students.Names()[b]);
+            if (order != 0) return order < 0;
+            return students.Ids()[a] < students.Ids()[b];
+        }
+    };
+
+    static uint64_t Key(Symbol className, Symbol section) {
+        return (uint64_t(className) << 32) | section;
+    }
+
+    Section& GetOrAdd(const StudentTable& students, int slot) {
+        Symbol cls = students.ClassNames()[slot];
+        Symbol sec = students.Sections()[slot];
+        auto [it, added] = lookup.try_emplace(Key(cls, sec), static_cast<int>(sections.size()));
+        if (added) sections.push_back(Section{ cls, sec, {} });
+        return sections[it->second];
+    }
+
+    static void Renumber(StudentTable& students, const Section& sec, size_t from) {
+        for (size_t i = from; i < sec.members.size(); ++i)
+            students[sec.members[i]].setRollNumber(static_cast<int>(i) + 1);
+    }
+
+    std::vector<Section> sections;
+    std::unordered_map<uint64_t, int> lookup; // Key -> index into sections
+    size_t touchedCount = 0;
+};
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// A read-only view of contiguous elements owned elsewhere (C++17 has no
+// std::span). Valid until the owner's storage changes.
+template <typename T>
+class Span {
+public:
+    Span() = default;
+    Span(const T* data, size_t size) : first(data), count(size) {}
+    Span(const std::vector<T>& v) : first(v.data()), count(v.size()) {}
+
+    const T* begin() const { return first; }
+    const T* end() const { return first + count; }
+    const T* data() const { return first; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const T& operator[](size_t i) const { return first[i]; }
+    const T& front() const { return first[0]; }
+
+private:
+    const T* first = nullptr;
+    size_t count = 0;
+};
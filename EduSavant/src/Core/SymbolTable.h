@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Interned ID for a short, frequently repeated string (class, section,
+// subject, role). 0 is always the empty string.
+using Symbol = uint32_t;
+constexpr Symbol kEmptySymbol = 0;
+constexpr Symbol kNoSymbol = UINT32_MAX;
+
+// Process-wide string interner. Strings are never freed or moved, so Str()
+// and View() references stay valid for the life of the program and may be
+// read from any thread without locking; Intern() and Find() take a mutex.
+class SymbolTable {
+public:
+    static SymbolTable& Get() {
+        static SymbolTable instance;
+        return instance;
+    }
+
+    Symbol Intern(std::string_view s) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = lookup.find(s);
+        if (it != lookup.end()) return it->second;
+
+        Symbol id = count.load(std::memory_order_relaxed);
+        auto& chunk = chunks[id / kChunkSize];
+        if (!chunk) chunk = std::make_unique<std::string[]>(kChunkSize);
+        std::string& slot = chunk[id % kChunkSize];
+        slot.assign(s);
+        lookup.emplace(std::string_view(slot), id);
+        count.store(id + 1, std::memory_order_release);
+        return id;
+    }
+
+    // Returns kNoSymbol if s was never interned (nothing is added).
+    Symbol Find(std::string_view s) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = lookup.find(s);
+        return it == lookup.end() ? kNoSymbol : it->second;
+    }
+
+    const std::string& Str(Symbol id) const { return chunks[id / kChunkSize][id % kChunkSize]; }
+    std::string_view View(Symbol id) const { return Str(id); }
+
+    size_t Size() const { return count.load(std::memory_order_acquire); }
+
+private:
+    static constexpr size_t kChunkSize = 1024;
+    static constexpr size_t kMaxChunks = 4096; // ~4M distinct strings
+
+    SymbolTable() { Intern(std::string_view()); }
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string_view, Symbol> lookup;
+    std::unique_ptr<std::string[]> chunks[kMaxChunks];
+    std::atomic<Symbol> count{0};
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One thread per core beyond the first, started on first use and kept for
+// the life of the program, that ParallelFor() lends to one loop at a time.
+// Loops that run every time the data changes reuse them instead of creating
+// and joining threads on each call.
+class WorkerPool {
+public:
+    static WorkerPool& Get() {
+        static WorkerPool instance;
+        return instance;
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) t.join();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Threads a loop can use, counting the caller.
+    unsigned Size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Runs fn(0) .. fn(tasks - 1) on the calling thread and up to
+    // threads - 1 pool threads; returns once every call has. Loops from
+    // different threads take turns.
+    template <typename Fn>
+    void ParallelFor(size_t tasks, unsigned threads, Fn&& fn) {
+        std::lock_guard<std::mutex> turn(loopMutex);
+        std::atomic<size_t> next{0};
+        auto run = [&] {
+            for (size_t i; (i = next++) < tasks;) fn(i);
+        };
+        unsigned helpers = std::min(threads, Size()) - 1;
+        if (helpers > 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = run;
+            wanted = helpers;
+            claimed = done = 0;
+            ++generation;
+        }
+        wake.notify_all();
+        run();
+        if (helpers == 0) return;
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return done == wanted; });
+        job = nullptr; // It refers to this frame
+    }
+
+private:
+    WorkerPool() {
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned t = 1; t < cores; ++t) workers.emplace_back([this] { WorkerLoop(); });
+    }
+
+    void WorkerLoop() {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this, &seen] { return stopping || (generation != seen && claimed < wanted); });
+            if (stopping) return;
+            seen = generation; // At most one share of each loop
+            ++claimed;
+            std::function<void()> fn = job;
+            lock.unlock();
+            fn();
+            lock.lock();
+            if (++done == wanted) finished.notify_one();
+        }
+    }
+
+    std::mutex loopMutex; // Held for a whole ParallelFor()
+    std::mutex mutex;     // Guards everything below
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::function<void()> job;
+    uint64_t generation = 0;
+    unsigned wanted = 0, claimed = 0, done = 0;
+    bool stopping = false;
+
+    std::vector<std::thread> workers; // Declared last so they start after the members above
+};
@@ -5,102 +5,495 @@
 #include <sstream>
 #include <iostream>
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <utility>
 #include "Models/Student.h"
+#include "Models/StudentTable.h"
 #include "Models/Staff.h" 
 #include "Models/ClassConfig.h"
+#include "Core/IdIndex.h"
+#include "Core/MarkAnalytics.h"
+#include "Core/Profiler.h"
+#include "Core/Promotion.h"
+#include "Core/RosterStats.h"
+#include "Core/SearchIndex.h"
+#include "Core/SectionIndex.h"
+#include "Core/SymbolTable.h"
+#include "Storage/MappedFile.h"
+#include "Storage/Export.h"
+#include "Storage/StudentBinary.h"
+#include "Storage/Journal.h"
+#include "Storage/PersistenceService.h"
 
 class DataManager {
 public:
-    std::vector<Student> students;
+    StudentTable students; // Columnar; index it by slot to get a row view
     std::vector<Staff> staffMembers;
 
     DataManager() {
+        persistence.SetIdleCallback([this] { journal.Sync(); });
         LoadClassConfig();
         LoadStudents();
         LoadStaff();
     }
 
+    ~DataManager() {
+        FinishImport(true);
+        Flush();
+    }
+
+    DataManager(const DataManager&) = delete;
+    DataManager& operator=(const DataManager&) = delete;
+
     // --- Students ---
+    // Every mutation appends one record to students.journal instead of
+    // rewriting students.db; see the Persistence section below.
+    // Roll numbers are kept current incrementally: only the affected
+    // section is renumbered.
     void AddStudent(const Student& s) {
-        students.push_back(s);
-        RecalculateRollNumbers(); // Auto-sort and assign roll nos
-        SaveStudents();
+        PutStudent(s);
+        Storage::EncodePutStudent(journalRecord, s);
+        AppendJournal();
     }
     
     void DeleteStudent(int id) {
-        students.erase(std::remove_if(students.begin(), students.end(), 
-            [id](const Student& s){ return s.getId() == id; }), students.end());
-        
-        RecalculateRollNumbers(); // Re-assign roll nos after delete
+        if (!RemoveStudent(id)) return;
+        journalRecord.Begin(Storage::JournalOp::DeleteStudent);
+        journalRecord.Put<int32_t>(id);
+        AppendJournal();
+    }
+
+    // O(1) via studentIndex. The row is invalidated by any add or delete.
+    std::optional<StudentTable::Row> FindStudent(int id) {
+        int slot = studentIndex.Find(id);
+        if (slot == IdIndex::kNotFound) return std::nullopt;
+        return students[slot];
+    }
+
+    // Applies the profile modal's edits; only fields that changed are journaled.
+    void UpdateStudentDetails(int id, const std::string& name, const std::string& fatherName,
+                              const std::string& phone, const std::string& email) {
+        std::optional<StudentTable::Row> s = FindStudent(id);
+        if (!s) return;
+        if (s->getName() != name) SetStudentField(*s, Storage::StudentField::Name, name);
+        if (s->getFatherName() != fatherName) SetStudentField(*s, Storage::StudentField::FatherName, fatherName);
+        if (s->getPhone() != phone) SetStudentField(*s, Storage::StudentField::Phone, phone);
+        if (s->getEmail() != email) SetStudentField(*s, Storage::StudentField::Email, email);
+    }
+
+    // Places a student in another class/section; both sections are renumbered.
+    void MoveStudent(int id, const std::string& className, const std::string& section) {
+        std::optional<StudentTable::Row> s = FindStudent(id);
+        if (!s) return;
+        if (s->getClassName() != className) SetStudentField(*s, Storage::StudentField::ClassName, className);
+        if (s->getSection() != section) SetStudentField(*s, Storage::StudentField::Section, section);
+    }
+
+    void SetStudentMark(int id, int term, Symbol subject, int mark) {
+        std::optional<StudentTable::Row> s = FindStudent(id);
+        if (!s) return;
+        SetMark(*s, term, subject, mark);
+        journalRecord.Begin(Storage::JournalOp::SetMark);
+        journalRecord.Put<int32_t>(id);
+        journalRecord.Put<uint16_t>(static_cast<uint16_t>(term));
+        journalRecord.PutString(SymbolTable::Get().View(subject));
+        journalRecord.Put<int32_t>(mark);
+        AppendJournal();
+    }
+
+    void SetStudentAttendance(int id, float attendance) {
+        std::optional<StudentTable::Row> s = FindStudent(id);
+        if (!s || s->getAttendance() == attendance) return;
+        ApplyStudentField(*s, Storage::StudentField::Attendance, {}, attendance);
+        journalRecord.Begin(Storage::JournalOp::SetField);
+        journalRecord.Put<int32_t>(id);
+        journalRecord.Put<uint8_t>(static_cast<uint8_t>(Storage::StudentField::Attendance));
+        journalRecord.Put<float>(attendance);
+        AppendJournal();
+    }
+
+    struct ImportSummary {
+        size_t added = 0;
+        size_t replaced = 0;
+    };
+
+    // Merges rows parsed by Storage::CsvStudentImport, moving them out of
+    // `rows`. A row whose ID already exists replaces that student; rows
+    // without an ID get fresh ones, above every ID in the file.
+    //
+    // Only the rows are placed here. The whole-roster index builds (search
+    // postings, section order and roll numbers, stats) run on a background
+    // thread over a copy-on-write snapshot of the roster; FinishImport()
+    // swaps them in and saves the roster as one snapshot rather than a
+    // journal record per student. Until then Stats(), Sections(), search and
+    // the new students' roll numbers are from before the import, and the
+    // roster must not be edited (the import dialog stays open meanwhile).
+    // onReady runs on the background thread once FinishImport() would succeed.
+    ImportSummary BeginImport(StudentTable& rows, std::function<void()> onReady = {}) {
+        PROFILE_SCOPE("DataManager::BeginImport");
+        ImportSummary summary;
+        const CowColumn<int>& ids = rows.Ids();
+        int nextId = std::max(maxStudentId, ids.empty() ? 0 : *std::max_element(ids.begin(), ids.end()));
+        students.reserve(students.size() + rows.size());
+        studentIndex.Reserve(students.size() + rows.size());
+        for (int i = 0; i < static_cast<int>(rows.size()); ++i) {
+            int id = ids[i] > 0 ? ids[i] : ++nextId;
+            int slot = studentIndex.Find(id);
+            if (slot != IdIndex::kNotFound) {
+                students.Assign(slot, rows[i].ToStudent());
+                ++summary.replaced;
+            } else {
+                slot = static_cast<int>(students.size());
+                studentIndex.Insert(id, slot);
+                students.Take(rows, i, id);
+                ++summary.added;
+            }
+            LayoutMarks(students[slot]);
+        }
+        maxStudentId = std::max(maxStudentId, nextId);
+        rows.clear();
+        ++rosterVersion;
+        StartIndexBuild(std::move(onReady));
+        return summary;
+    }
+
+    bool ImportPending() const { return indexBuild != nullptr; }
+
+    // Swaps in the indexes built for the last BeginImport() once they are
+    // ready; returns whether the import is complete. Call once per frame, or
+    // with wait = true to block until it is.
+    bool FinishImport(bool wait = false) {
+        if (!indexBuild) return true;
+        if (!wait && !indexBuild->finished.load(std::memory_order_acquire)) return false;
+        PROFILE_SCOPE("DataManager::FinishImport");
+        indexBuilder.join();
+        std::unique_ptr<IndexBuild> build = std::move(indexBuild);
+        if (build->rosterVersion != rosterVersion || build->marksVersion != marksVersion) {
+            // The roster changed under the build; start over from the current one
+            StartIndexBuild(std::move(build->onReady));
+            return wait ? FinishImport(true) : false;
+        }
+        students.AdoptRollNumbers(build->roster);
+        sectionIndex = std::move(build->sections);
+        stats = std::move(build->stats);
+        studentSearch = std::move(build->search);
+        ++rosterVersion;
         SaveStudents();
+        return true;
     }
 
-    void RecalculateRollNumbers() {
-        // 1. Sort global list by Name (Ascending)
-        std::sort(students.begin(), students.end(), [](const Student& a, const Student& b) {
-            // Sort by Class -> Section -> Name
-            if (a.getClassName() != b.getClassName()) return a.getClassName() < b.getClassName();
-            if (a.getSection() != b.getSection()) return a.getSection() < b.getSection();
-            return a.getName() < b.getName();
-        });
+    // BeginImport() and FinishImport() back to back, for the CLI.
+    ImportSummary ImportStudents(StudentTable& rows) {
+        ImportSummary summary = BeginImport(rows);
+        FinishImport(true);
+        return summary;
+    }
 
-        // 2. Assign Roll Numbers sequentially per section
-        std::map<std::string, int> sectionRollCounters; // Key: "Class-Section"
-        
-        for (auto& s : students) {
-            std::string key = s.getClassName() + "-" + s.getSection();
-            sectionRollCounters[key]++;
-            s.setRollNumber(sectionRollCounters[key]);
+    // --- Batches ---
+    // Groups many student adds, deletes, moves and edits into one unit.
+    // Inside a batch, sections are only marked as touched. Commit()
+    // regroups and renumbers each touched section once, in one pass over
+    // the roster. It journals the whole batch as one record: a crash keeps
+    // either all of it or none. Stats, search and the ID index stay current
+    // throughout. Roll numbers and Sections() are stale until the outermost
+    // Commit(). Batches nest.
+    void BeginBatch() {
+        if (batchDepth++ > 0) return;
+        batchRecord.Begin(Storage::JournalOp::Batch);
+    }
+
+    void Commit() {
+        if (batchDepth == 0 || --batchDepth > 0) return;
+        PROFILE_SCOPE("DataManager::Commit");
+        if (sectionIndex.RegroupTouched(students)) ++rosterVersion;
+        if (batchRecord.Payload().size() > 1) { // Anything was recorded
+            std::swap(journalRecord, batchRecord);
+            AppendJournal();
         }
     }
 
-    int getNextStudentId() {
-        int maxId = 0;
-        for(const auto& s : students) if(s.getId() > maxId) maxId = s.getId();
-        return maxId + 1;
+    bool InBatch() const { return batchDepth > 0; }
+
+    // --- Promotion ---
+    struct PromotionSummary {
+        size_t promoted = 0;
+        size_t graduated = 0;
+        size_t unchanged = 0; // In classes the plan doesn't mention
+    };
+
+    // What Promote() would do, from the dashboard counts; changes nothing.
+    PromotionSummary PreviewPromotion(const PromotionPlan& plan) const {
+        PromotionSummary summary;
+        SymbolTable& symbols = SymbolTable::Get();
+        for (const PromotionPlan::Step& step : plan.steps) {
+            auto group = stats.Classes().find(symbols.Find(step.fromClass));
+            size_t count = group == stats.Classes().end() ? 0 : group->second.count;
+            (step.toClass.empty() ? summary.graduated : summary.promoted) += count;
+        }
+        summary.unchanged = students.size() - summary.promoted - summary.graduated;
+        return summary;
+    }
+
+    // Applies a plan (check plan.Problems() first) in one pass over the
+    // roster: placements are rewritten in place, graduates are compacted out
+    // into `archivePath`, and every section is renumbered once at the end.
+    // Students in a section the plan doesn't list go to the target class's
+    // first section. The archive (merged with an existing one, by ID) is
+    // written by the same job as the roster snapshot that drops the
+    // graduates, and if it can't be written the snapshot isn't either; the
+    // graduates stay queued and every later snapshot tries them again first.
+    // The job is queued before this returns: a promotion is too large for
+    // the journal, and the snapshot replaces students.db in one rename, so
+    // after a crash or a failed archive the roster on disk is either wholly
+    // promoted or not at all.
+    PromotionSummary Promote(const PromotionPlan& plan, const std::string& archivePath) {
+        PROFILE_SCOPE("DataManager::Promote");
+        struct ClassMove {
+            bool graduates = false;
+            Symbol toClass = kNoSymbol;
+            std::unordered_map<Symbol, Symbol> sections;
+        };
+        SymbolTable& symbols = SymbolTable::Get();
+        std::unordered_map<Symbol, ClassMove> moves;
+        for (const PromotionPlan::Step& step : plan.steps) {
+            ClassMove& move = moves[symbols.Intern(step.fromClass)];
+            move.graduates = step.toClass.empty();
+            if (move.graduates) continue;
+            move.toClass = symbols.Intern(step.toClass);
+            for (const auto& [from, to] : step.sections) move.sections[symbols.Intern(from)] = symbols.Intern(to);
+            const ClassConfig& config = ClassConfig::Get();
+            ClassId target = config.FindClass(move.toClass);
+            if (target != kNoClass && !config.Sections(target).empty()) // Unlisted sections
+                move.sections.try_emplace(kNoSymbol, config.Section(config.Sections(target).front()).symbol);
+        }
+
+        PromotionSummary summary;
+        StudentTable graduates;
+        int kept = 0;
+        const int count = static_cast<int>(students.size());
+        for (int slot = 0; slot < count; ++slot) {
+            auto move = moves.find(students.ClassNames()[slot]);
+            if (move != moves.end() && move->second.graduates) {
+                int id = students.Ids()[slot];
+                studentSearch.Remove(id);
+                graduates.Take(students, slot, id);
+                ++summary.graduated;
+                continue;
+            }
+            if (slot != kept) students.MoveRow(slot, kept);
+            StudentTable::Row s = students[kept++];
+            if (move == moves.end()) {
+                ++summary.unchanged;
+                continue;
+            }
+            const auto& sections = move->second.sections;
+            auto section = sections.find(s.getSectionSymbol());
+            if (section == sections.end()) section = sections.find(kNoSymbol);
+            if (section == sections.end()) { // Target class has no sections; stay put
+                ++summary.unchanged;
+                continue;
+            }
+            s.setPlacement(move->second.toClass, section->second);
+            if (plan.resetRecords) {
+                s.clearMarks();
+                s.setAttendance(0.0f);
+            }
+            LayoutMarks(s);
+            ++summary.promoted;
+        }
+        while (static_cast<int>(students.size()) > kept) students.PopBack();
+
+        RebuildStudentIndex();
+        stats.Rebuild(students);
+        RecalculateRollNumbers();
+        if (!graduates.empty()) {
+            persistence.Submit([this, graduates = std::move(graduates), archivePath] {
+                unarchived.push_back({ archivePath, graduates }); // Written by the snapshot job below
+                return true;
+            }, "archive");
+        }
+        studentsDirty = false;
+        QueueStudentSnapshot();
+        return summary;
+    }
+
+    // Adds students to a students.db-format archive, skipping IDs it already holds.
+    static bool WriteArchive(const std::string& path, const StudentTable& added) {
+        PROFILE_SCOPE("DataManager::WriteArchive");
+        StudentTable archive;
+        {
+            Storage::MappedFile file(path);
+            if (file.size() > 0 && !Storage::ReadStudentDb(file.view(), archive)) return false; // Don't overwrite what we can't read
+        }
+        std::unordered_set<int> present(archive.Ids().begin(), archive.Ids().end());
+        archive.reserve(archive.size() + added.size());
+        for (int slot = 0; slot < static_cast<int>(added.size()); ++slot)
+            if (present.insert(added.Ids()[slot]).second) archive.Append(added[slot].ToStudent());
+        std::error_code ec;
+        std::filesystem::path parent = std::filesystem::path(path).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent, ec);
+        return Storage::WriteStudentDb(path + ".tmp", archive) && Storage::ReplaceFile(path + ".tmp", path);
     }
+
+    // Forces pending journal records to disk (otherwise fsync'd in batches).
+    void SyncJournal() {
+        persistence.Submit([this] { return journal.Sync(); }, "journal");
+    }
+
+    // Full regroup and renumber of every section. Normal edits maintain roll
+    // numbers incrementally; this is for loads and bulk changes, which may
+    // suspend per-record maintenance and call it once at the end.
+    void RecalculateRollNumbers() {
+        PROFILE_SCOPE("DataManager::RecalculateRollNumbers");
+        sectionIndex.Rebuild(students);
+        indexesStale = false;
+        ++rosterVersion;
+    }
+
+    // Totals and averages for the dashboard, always current.
+    const RosterStats& Stats() const { return stats; }
+
+    // Per-subject statistics, ranks and grades for every section, class and
+    // the school. The first call after a change to the roster, a mark or the
+    // class config starts a recomputation in the background; until it is
+    // done this returns the previous report (empty before the first one),
+    // unless `wait` is set.
+    const MarkReport& Analytics(bool wait = false) {
+        return analytics.Update(students, sectionIndex, ClassConfig::Get(), rosterVersion, marksVersion, wait);
+    }
+
+    bool AnalyticsPending() const { return analytics.Pending(); }
+    bool AnalyticsReady() const { return analytics.Ready(); }
+
+    // --- Search ---
+    // Slots of the students whose name, father's name, email or phone match
+    // the query (case-insensitive, typo-tolerant), best match first.
+    std::vector<int> SearchStudents(std::string_view query) const {
+        PROFILE_SCOPE("DataManager::SearchStudents");
+        std::vector<int> slots = studentSearch.Search(query);
+        for (int& id : slots) id = studentIndex.Find(id);
+        return slots;
+    }
+
+    // Same over staff name, email, phone and subject; slots into staffMembers.
+    std::vector<int> SearchStaff(std::string_view query) const {
+        PROFILE_SCOPE("DataManager::SearchStaff");
+        std::vector<int> slots = staffSearch.Search(query);
+        for (int& id : slots) id = staffIndex.Find(id);
+        return slots;
+    }
+
+    // --- Section index ---
+    const SectionIndex& Sections() const { return sectionIndex; }
+
+    // The students of one class-section in roll order; nullptr if it has none.
+    const SectionIndex::Section* FindSection(Symbol className, Symbol section) const {
+        return sectionIndex.Find(className, section);
+    }
+
+    // Bumped whenever a student is added, removed, renamed or renumbered, and
+    // on reload. UI views cache filtered rows against it. Marks don't count.
+    uint64_t RosterVersion() const { return rosterVersion; }
+    uint64_t StaffVersion() const { return staffVersion; }
+
+    // IDs only grow, so a deleted student's ID is never handed out again.
+    int getNextStudentId() const { return maxStudentId + 1; }
     
     // --- Staff ---
     void AddStaff(const Staff& s) {
+        staffIndex.Insert(s.getId(), static_cast<int>(staffMembers.size()));
         staffMembers.push_back(s);
+        IndexStaffText(staffMembers.back());
+        maxStaffId = std::max(maxStaffId, s.getId());
+        ++staffVersion;
         SaveStaff();
     }
     
     void DeleteStaff(int id) {
-        staffMembers.erase(std::remove_if(staffMembers.begin(), staffMembers.end(), 
-            [id](const Staff& s){ return s.getId() == id; }), staffMembers.end());
+        int slot = staffIndex.Find(id);
+        if (slot == IdIndex::kNotFound) return;
+        // Swap-and-pop: the last member takes the freed slot
+        staffIndex.Erase(id);
+        staffSearch.Remove(id);
+        if (slot != static_cast<int>(staffMembers.size()) - 1) {
+            staffMembers[slot] = std::move(staffMembers.back());
+            staffIndex.Insert(staffMembers[slot].getId(), slot);
+        }
+        staffMembers.pop_back();
+        ++staffVersion;
+        SaveStaff();
+    }
+
+    Staff* FindStaff(int id) {
+        int slot = staffIndex.Find(id);
+        return slot == IdIndex::kNotFound ? nullptr : &staffMembers[slot];
+    }
+
+    int getNextStaffId() const { return maxStaffId + 1; }
+
+    // Removes every student and staff member ("Reset All Data").
+    void ClearAll() {
+        students.clear();
+        sectionIndex.Clear();
+        stats.Clear();
+        studentSearch.Clear();
+        staffSearch.Clear();
+        staffMembers.clear();
+        studentIndex.Clear();
+        staffIndex.Clear();
+        ++rosterVersion;
+        ++staffVersion;
+        SaveStudents();
         SaveStaff();
     }
     
     // --- Class Config ---
     void SaveClassConfig() {
-        std::ofstream file("class_config.db");
-        if (!file.is_open()) return;
+        classConfigDirty = true;
+        for (int slot = 0; slot < static_cast<int>(students.size()); ++slot)
+            LayoutMarks(students[slot]); // Subject lists may have changed
+    }
+
+    static bool WriteClassConfig(const std::string& path, const ClassConfig& config) {
+        PROFILE_SCOPE("DataManager::WriteClassConfig");
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
         
         // Format: CLASS|ClassName|Section1,Section2,...
         // Format: SUBJECT|ClassName|SectionName|Sub1,Sub2,...
         
-        for (auto const& [className, sections] : ClassConfig::Get().classesAndSections) {
-            file << "CLASS|" << className << "|";
+        for (ClassId cls : config.Classes()) {
+            Span<SectionId> sections = config.Sections(cls);
+            file << "CLASS|" << config.Class(cls).name << "|";
             for (size_t i = 0; i < sections.size(); ++i) {
-                file << sections[i] << (i == sections.size() - 1 ? "" : ",");
+                file << config.Section(sections[i]).name << (i == sections.size() - 1 ? "" : ",");
             }
             file << "\n";
         }
 
-        for (auto const& [className, secMap] : ClassConfig::Get().sectionSubjects) {
-            for (auto const& [sectionName, subjects] : secMap) {
-                file << "SUBJECT|" << className << "|" << sectionName << "|";
+        for (ClassId cls : config.Classes()) {
+            for (SectionId sec : config.Sections(cls)) {
+                Span<Symbol> subjects = config.Subjects(sec);
+                file << "SUBJECT|" << config.Class(cls).name << "|" << config.Section(sec).name << "|";
                 for (size_t i = 0; i < subjects.size(); ++i) {
-                    file << subjects[i] << (i == subjects.size() - 1 ? "" : ",");
+                    file << SymbolTable::Get().View(subjects[i]) << (i == subjects.size() - 1 ? "" : ",");
                 }
                 file << "\n";
             }
         }
+        Profiler::CountBytesWritten(static_cast<size_t>(std::max<std::streamoff>(file.tellp(), 0)));
         file.close();
+        return bool(file);
     }
 
     void LoadClassConfig() {
+        PROFILE_SCOPE("DataManager::LoadClassConfig");
         std::ifstream file("class_config.db");
         if (!file.is_open()) return;
 
@@ -139,82 +532,195 @@ public:
     }
 
     // --- Persistence ---
-    void SaveStudents() {
-        std::ofstream file("students.db");
-        if (!file.is_open()) return;
+    // All writes happen on the persistence thread; the Save* functions only
+    // mark a dataset dirty and Pump() (once per frame) hands an immutable copy
+    // of each dirty dataset to the worker, so bursts of saves coalesce into
+    // one write and the render loop never waits on the disk. The roster's
+    // copy is a copy-on-write snapshot of its columns: taking it costs one
+    // pointer per 4096 rows, and later edits clone only the chunks they touch.
+    //
+    // students.db is a snapshot tagged with a generation; students.journal
+    // holds the mutations made since. Taking a snapshot rotates the live
+    // journal to students.journal.<generation>; segments are deleted once a
+    // newer snapshot is safely renamed into place, so a crash never leaves a
+    // torn roster. A journal past kJournalCompactBytes triggers a snapshot.
+    static constexpr size_t kJournalCompactBytes = 4u << 20;
 
-        // V2 Format: ID|Name|Email|Phone|Class|Section|RollNo|FatherName|Attendance|MARK_DATA
-        // MARK_DATA: Term:Sub:Score;Term:Sub:Score...
-        for (const auto& s : students) {
-            file << s.getId() << "|" << s.getName() << "|" << s.getEmail() << "|" 
-                 << s.getPhone() << "|" << s.getClassName() << "|" << s.getSection() << "|"
-                 << s.getRollNumber() << "|" << s.getFatherName() << "|" << s.getAttendance() << "|";
-            
-            // Serialize Marks
-            auto records = s.getAcademicRecord();
-            for(auto const& [term, subjects] : records) {
-                for(auto const& [sub, mark] : subjects) {
-                    file << term << ":" << sub << ":" << mark << ";";
-                }
-            }
-            file << "\n";
+    void SaveStudents() { studentsDirty = true; }
+    void SaveStaff() { staffDirty = true; }
+
+    void Pump() {
+        PROFILE_SCOPE("DataManager::Pump");
+        if (studentsDirty && !persistence.IsQueued("students")) {
+            studentsDirty = false;
+            QueueStudentSnapshot();
+        }
+        if (staffDirty && !persistence.IsQueued("staff")) {
+            staffDirty = false;
+            persistence.Submit([roster = staffMembers] {
+                return WriteStaff("staff.db.tmp", roster) && Storage::ReplaceFile("staff.db.tmp", "staff.db");
+            }, "staff");
+        }
+        if (classConfigDirty && !persistence.IsQueued("class_config")) {
+            classConfigDirty = false;
+            persistence.Submit([config = ClassConfig::Get()] {
+                return WriteClassConfig("class_config.db.tmp", config) &&
+                       Storage::ReplaceFile("class_config.db.tmp", "class_config.db");
+            }, "class_config");
         }
-        file.close();
     }
 
-    void LoadStudents() {
-        students.clear();
-        std::ifstream file("students.db");
-        if (!file.is_open()) return;
+    // Writes everything outstanding and waits for it. Blocks; not for per-frame use.
+    void Flush() {
+        PROFILE_SCOPE("DataManager::Flush");
+        do {
+            Pump();
+            persistence.WaitIdle();
+        } while (studentsDirty || staffDirty || classConfigDirty);
+    }
 
-        std::string line;
-        while (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string segment;
-            std::vector<std::string> parts;
-            while(std::getline(ss, segment, '|')) parts.push_back(segment);
+    // Called on the persistence thread whenever its queue drains, so an idle
+    // render loop can wake up and show the new save status.
+    void SetWakeCallback(std::function<void()> fn) {
+        persistence.SetIdleCallback([this, fn = std::move(fn)] {
+            journal.Sync();
+            if (fn) fn();
+        });
+    }
 
-            if (parts.size() >= 9) { // Ensure basic fields exist
-                int id = std::stoi(parts[0]);
-                Student s(id, parts[1], parts[2], parts[3], parts[4], parts[5], parts[7]);
-                s.setRollNumber(std::stoi(parts[6]));
-                s.setAttendance(std::stof(parts[8]));
-
-                // Parse marks if present (parts[9])
-                if (parts.size() > 9) {
-                    std::stringstream marksSS(parts[9]);
-                    std::string markEntry;
-                    while(std::getline(marksSS, markEntry, ';')) {
-                        if(markEntry.empty()) continue;
-                        // Term:Sub:Score
-                        size_t firstColon = markEntry.find(':');
-                        size_t secondColon = markEntry.rfind(':');
-                        if (firstColon != std::string::npos && secondColon != std::string::npos) {
-                            int term = std::stoi(markEntry.substr(0, firstColon));
-                            std::string sub = markEntry.substr(firstColon + 1, secondColon - firstColon - 1);
-                            int score = std::stoi(markEntry.substr(secondColon + 1));
-                            s.setMark(term, sub, score);
-                        }
-                    }
+    // --- Export ---
+    // Streams a dataset to options.path on the persistence thread. Student and
+    // mark exports read the students.db snapshot. If the journal holds changes
+    // the snapshot lacks, or the last snapshot never made it to disk, a new
+    // one is queued first, so the file reflects the roster exactly as it is
+    // now. Like any snapshot it shares the roster's columns copy-on-write (see
+    // Persistence); the export itself holds no copy of the rows. Should that
+    // snapshot fail, the export stops with progress->error rather than write
+    // out an older students.db.
+    std::shared_ptr<Storage::ExportProgress> Export(Storage::ExportOptions options) {
+        auto progress = std::make_shared<Storage::ExportProgress>();
+        if (options.dataset == Storage::ExportDataset::Staff) {
+            persistence.Submit([roster = staffMembers, options = std::move(options), progress] {
+                PROFILE_SCOPE("DataManager::ExportStaff");
+                Storage::ExportStaff(roster, options, *progress);
+                return true;
+            });
+            return progress;
+        }
+        if (studentsUnreadable) {
+            progress->error = "students.db could not be read; nothing was exported";
+            progress->finished.store(true, std::memory_order_release);
+            return progress;
+        }
+        std::error_code ec;
+        if (studentsDirty || journalBytes > 0 || snapshotWritten.load(std::memory_order_acquire) != snapshotGeneration ||
+            !std::filesystem::exists("students.db", ec)) {
+            studentsDirty = false;
+            QueueStudentSnapshot();
+        }
+        persistence.Submit([this, generation = snapshotGeneration, options = std::move(options), progress] {
+            PROFILE_SCOPE("DataManager::ExportStudents");
+            if (snapshotWritten.load(std::memory_order_acquire) < generation) {
+                progress->error = "Could not save the roster to students.db; nothing was exported";
+                progress->finished.store(true, std::memory_order_release);
+                return true; // The failed snapshot is already reported
+            }
+            Storage::MappedFile file("students.db");
+            Storage::ExportStudentDb(file.view(), options, *progress);
+            return true; // Export problems are reported through progress, not as a failed save
+        });
+        return progress;
+    }
+
+    Storage::PersistenceService::Status GetSaveStatus() const { return persistence.GetStatus(); }
+
+    // students.db exists but is corrupt or from a newer version. The roster
+    // starts empty and nothing is saved: no journal records, no snapshot, no
+    // student export, so the file is left for recovery rather than replaced.
+    bool StudentsUnreadable() const { return studentsUnreadable; }
+    double SecondsSinceLastSave() const { return persistence.SecondsSinceLastSave(); }
+
+    void LoadStudents() {
+        PROFILE_SCOPE("DataManager::LoadStudents");
+        Flush();
+        journal.Close();
+        students.clear();
+        indexesStale = true; // Rebuilt once, after the journals are replayed
+        studentsUnreadable = false;
+        uint64_t diskGeneration = 0;
+        {
+            Storage::MappedFile file("students.db");
+            if (Storage::IsStudentDb(file.view())) {
+                if (!Storage::ReadStudentDb(file.view(), students, &diskGeneration)) {
+                    std::cerr << "students.db is corrupt or from a newer version; not loaded, and not saved over\n";
+                    students.clear();
+                    studentsUnreadable = true;
                 }
-                students.push_back(s);
+            } else if (file.size() > 0) {
+                // One-shot migration from the V2 text format: keep the original as
+                // a backup and rewrite it in the binary layout.
+                Storage::ReadStudentsText(file.view(), students);
+                file.Close();
+                std::error_code ec;
+                std::filesystem::copy_file("students.db", "students.db.v2.bak",
+                                           std::filesystem::copy_options::overwrite_existing, ec);
+                if (!ec) studentsDirty = true;
             }
         }
-        file.close();
+        snapshotGeneration = diskGeneration;
+        snapshotWritten.store(diskGeneration, std::memory_order_release);
+        RebuildStudentIndex();
+        ++rosterVersion;
+
+        // Rotated segments only survive a snapshot that never completed.
+        std::vector<uint64_t> segments = ListJournalSegments();
+        for (uint64_t generation : segments) {
+            uint64_t fileGeneration = 0;
+            size_t validLength = 0;
+            ReplayJournal(JournalSegmentPath(generation), diskGeneration, fileGeneration, validLength);
+            snapshotGeneration = std::max(snapshotGeneration, generation);
+        }
+        if (!segments.empty()) studentsDirty = true; // Fold them into a fresh snapshot
+
+        uint64_t liveGeneration = 0;
+        size_t validLength = 0;
+        ReplayJournal("students.journal", diskGeneration, liveGeneration, validLength);
+        if (validLength > 0 && liveGeneration >= diskGeneration) {
+            journalGeneration = liveGeneration;
+            snapshotGeneration = std::max(snapshotGeneration, liveGeneration);
+            journalBytes = validLength;
+        } else {
+            journalGeneration = snapshotGeneration;
+            journalBytes = validLength = 0;
+        }
+        if (!studentsUnreadable) journal.Open("students.journal", journalGeneration, validLength);
+
+        studentSearch.Clear();
+        studentSearch.Reserve(students.size());
+        for (int slot = 0; slot < static_cast<int>(students.size()); ++slot) {
+            LayoutMarks(students[slot]);
+            IndexStudentText(students[slot]);
+        }
+        stats.Rebuild(students);
+        RecalculateRollNumbers(); // Builds the section index
     }
 
-    void SaveStaff() {
-        std::ofstream file("staff.db");
-        if (!file.is_open()) return;
+    static bool WriteStaff(const std::string& path, const std::vector<Staff>& roster) {
+        PROFILE_SCOPE("DataManager::WriteStaff");
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
         // Format: ID|Name|Email|Phone|Role|Subject
-        for (const auto& t : staffMembers) {
+        for (const auto& t : roster) {
             file << t.getId() << "|" << t.getName() << "|" << t.getEmail() << "|" 
                  << t.getPhone() << "|" << t.getRole() << "|" << t.getSubject() << "\n";
         }
+        Profiler::CountBytesWritten(static_cast<size_t>(std::max<std::streamoff>(file.tellp(), 0)));
         file.close();
+        return bool(file);
     }
 
     void LoadStaff() {
+        PROFILE_SCOPE("DataManager::LoadStaff");
         staffMembers.clear();
         std::ifstream file("staff.db");
         if (!file.is_open()) return;
@@ -232,5 +738,353 @@ public:
             }
         }
         file.close();
+
+        staffIndex.Clear();
+        staffIndex.Reserve(staffMembers.size());
+        staffSearch.Clear();
+        maxStaffId = 0;
+        for (size_t i = 0; i < staffMembers.size(); ++i) {
+            staffIndex.Insert(staffMembers[i].getId(), static_cast<int>(i));
+            IndexStaffText(staffMembers[i]);
+            maxStaffId = std::max(maxStaffId, staffMembers[i].getId());
+        }
+        ++staffVersion;
+    }
+
+private:
+    IdIndex studentIndex; // Student ID -> slot in students
+    IdIndex staffIndex;   // Staff ID -> slot in staffMembers
+    SearchIndex studentSearch; // Keyed by student ID
+    SearchIndex staffSearch;   // Keyed by staff ID
+    int maxStudentId = 0;
+    int maxStaffId = 0;
+    uint64_t rosterVersion = 0;
+    uint64_t staffVersion = 0;
+    uint64_t marksVersion = 0;
+
+    SectionIndex sectionIndex;
+    RosterStats stats;
+    MarkAnalytics analytics;
+    bool indexesStale = false; // Set while a load skips per-record section, stats and search maintenance
+    bool studentsUnreadable = false; // See StudentsUnreadable()
+
+    // Indexes for the roster as it was after BeginImport(), built off the UI thread.
+    struct IndexBuild {
+        StudentTable roster; // Copy-on-write snapshot; only its roll numbers are rewritten
+        SectionIndex sections;
+        RosterStats stats;
+        SearchIndex search;
+        uint64_t rosterVersion = 0; // Of `students` when the snapshot was taken
+        uint64_t marksVersion = 0;
+        std::function<void()> onReady;
+        std::atomic<bool> finished{false};
+    };
+    std::unique_ptr<IndexBuild> indexBuild;
+    std::thread indexBuilder;
+
+    Storage::PersistenceService persistence;
+    bool studentsDirty = false;
+    bool staffDirty = false;
+    bool classConfigDirty = false;
+
+    // Owned by the persistence thread once loading is done.
+    Storage::JournalWriter journal;
+    uint64_t journalGeneration = 0;
+    struct Unarchived {
+        std::string path;
+        StudentTable graduates;
+    };
+    std::vector<Unarchived> unarchived; // Promoted out of the roster, not yet in their archive
+
+    Storage::JournalRecord journalRecord;
+    Storage::JournalRecord batchRecord; // Records of the open batch, journaled by Commit()
+    int batchDepth = 0;
+    uint64_t snapshotGeneration = 0; // Generation of the newest snapshot queued
+    std::atomic<uint64_t> snapshotWritten{0}; // Newest one safely in students.db; set by the persistence thread
+    size_t journalBytes = 0;         // Live journal size as seen by the UI thread
+
+    void RebuildStudentIndex() {
+        studentIndex.Clear();
+        studentIndex.Reserve(students.size());
+        const CowColumn<int>& ids = students.Ids();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            studentIndex.Insert(ids[i], static_cast<int>(i));
+            maxStudentId = std::max(maxStudentId, ids[i]);
+        }
+    }
+
+    void StartIndexBuild(std::function<void()> onReady) {
+        indexBuild = std::make_unique<IndexBuild>();
+        IndexBuild* build = indexBuild.get();
+        build->roster = students;
+        build->sections = sectionIndex; // Keeps its (possibly empty) sections in place
+        build->rosterVersion = rosterVersion;
+        build->marksVersion = marksVersion;
+        build->onReady = std::move(onReady);
+        indexBuilder = std::thread([build] {
+            PROFILE_SCOPE("DataManager::BuildIndexes");
+            StudentTable& roster = build->roster;
+            build->sections.Rebuild(roster);
+            build->stats.Rebuild(roster);
+            build->search.Reserve(roster.size());
+            for (int slot = 0; slot < static_cast<int>(roster.size()); ++slot)
+                IndexStudentText(build->search, std::as_const(roster)[slot]);
+            build->finished.store(true, std::memory_order_release);
+            if (build->onReady) build->onReady();
+        });
+    }
+
+    // Inserts, or replaces the student with the same ID.
+    void PutStudent(const Student& s) {
+        maxStudentId = std::max(maxStudentId, s.getId());
+        ++rosterVersion;
+        int slot = studentIndex.Find(s.getId());
+        if (slot != IdIndex::kNotFound) {
+            if (!indexesStale) {
+                LeaveSection(slot);
+                stats.RemoveStudent(students, slot);
+                stats.RemoveMarks(students.Marks()[slot]);
+            }
+            students.Assign(slot, s);
+        } else {
+            slot = static_cast<int>(students.size());
+            studentIndex.Insert(s.getId(), slot);
+            students.Append(s);
+        }
+        LayoutMarks(students[slot]);
+        if (!indexesStale) {
+            EnterSection(slot);
+            stats.AddStudent(students, slot);
+            stats.AddMarks(students.Marks()[slot]);
+            IndexStudentText(students[slot]);
+        }
+    }
+
+    // Swap-and-pop removal: the last student takes the freed slot.
+    bool RemoveStudent(int id) {
+        int slot = studentIndex.Find(id);
+        if (slot == IdIndex::kNotFound) return false;
+        int last = static_cast<int>(students.size()) - 1;
+        if (!indexesStale) {
+            LeaveSection(slot);
+            stats.RemoveStudent(students, slot);
+            stats.RemoveMarks(students.Marks()[slot]);
+            studentSearch.Remove(id);
+        }
+        studentIndex.Erase(id);
+        if (slot != last) {
+            if (!indexesStale) sectionIndex.Relocate(students, last, slot);
+            students.MoveRow(last, slot);
+            studentIndex.Insert(students[slot].getId(), slot);
+        }
+        students.PopBack();
+        ++rosterVersion;
+        return true;
+    }
+
+    static bool WriteStudentSnapshot(const StudentTable& roster, uint64_t generation) {
+        PROFILE_SCOPE("DataManager::WriteStudentSnapshot");
+        return Storage::WriteStudentDb("students.db.tmp", roster, generation) &&
+               Storage::ReplaceFile("students.db.tmp", "students.db");
+    }
+
+    void SetStudentField(StudentTable::Row s, Storage::StudentField field, const std::string& value) {
+        ApplyStudentField(s, field, value, 0.0f);
+        journalRecord.Begin(Storage::JournalOp::SetField);
+        journalRecord.Put<int32_t>(s.getId());
+        journalRecord.Put<uint8_t>(static_cast<uint8_t>(field));
+        journalRecord.PutString(value);
+        AppendJournal();
+    }
+
+    void ApplyStudentField(StudentTable::Row s, Storage::StudentField field, std::string_view text, float number) {
+        ++rosterVersion;
+        // Name, class and section decide where the student sits in roll order
+        int slot = s.slot();
+        bool moves = !indexesStale && (field == Storage::StudentField::Name ||
+                                       field == Storage::StudentField::ClassName ||
+                                       field == Storage::StudentField::Section);
+        // Class, section and attendance feed the dashboard aggregates
+        bool counted = !indexesStale && (field == Storage::StudentField::ClassName ||
+                                         field == Storage::StudentField::Section ||
+                                         field == Storage::StudentField::Attendance);
+        if (moves) LeaveSection(slot);
+        if (counted) stats.RemoveStudent(students, slot);
+        switch (field) {
+            case Storage::StudentField::Name:       s.setName(std::string(text)); break;
+            case Storage::StudentField::Email:      s.setEmail(std::string(text)); break;
+            case Storage::StudentField::Phone:      s.setPhone(std::string(text)); break;
+            case Storage::StudentField::FatherName: s.setFatherName(std::string(text)); break;
+            case Storage::StudentField::ClassName:  s.setClassName(text); break;
+            case Storage::StudentField::Section:    s.setSection(text); break;
+            case Storage::StudentField::Attendance: s.setAttendance(number); break;
+        }
+        if (moves) EnterSection(slot);
+        if (counted) stats.AddStudent(students, slot);
+        if (!indexesStale && !counted) IndexStudentText(s); // A searchable text field changed
+        if (field == Storage::StudentField::ClassName || field == Storage::StudentField::Section) LayoutMarks(s);
+    }
+
+    // Section index upkeep around a change to students[slot]. In a batch the
+    // section is only marked, and Commit() renumbers it once.
+    void LeaveSection(int slot) {
+        if (batchDepth > 0) sectionIndex.Touch(students, slot);
+        else sectionIndex.Remove(students, slot);
+    }
+    void EnterSection(int slot) {
+        if (batchDepth > 0) sectionIndex.Touch(students, slot);
+        else sectionIndex.Insert(students, slot);
+    }
+
+    void IndexStudentText(StudentTable::ConstRow s) { IndexStudentText(studentSearch, s); }
+
+    static void IndexStudentText(SearchIndex& search, StudentTable::ConstRow s) {
+        search.Put(s.getId(), { s.getName(), s.getFatherName(), s.getEmail(), s.getPhone() });
+    }
+
+    void IndexStaffText(const Staff& s) {
+        staffSearch.Put(s.getId(), { s.getName(), s.getEmail(), s.getPhone(), s.getSubject() });
+    }
+
+    void SetMark(StudentTable::Row s, int term, Symbol subject, int mark) {
+        if (term < 1 || term > MarkSheet::kTerms) return;
+        if (!indexesStale) stats.ChangeMark(term, subject, s.getMarks().Peek(term, subject), mark);
+        s.setMark(term, subject, mark);
+        ++marksVersion;
+    }
+
+    // Mark columns follow the section's subject list so the UI reads by slot.
+    static void LayoutMarks(StudentTable::Row s) {
+        s.layoutMarks(ClassConfig::Get().SubjectsOf(s.getClassSymbol(), s.getSectionSymbol()));
+    }
+
+    void AppendJournal() {
+        if (studentsUnreadable) return;
+        if (batchDepth > 0) { // Nested into the batch record
+            batchRecord.PutString(journalRecord.Payload());
+            return;
+        }
+        journalBytes += journalRecord.Payload().size() + 8;
+        persistence.Submit([this, record = journalRecord] {
+            PROFILE_SCOPE("DataManager::AppendJournal");
+            return journal.Append(record);
+        }, "journal");
+        if (journalBytes >= kJournalCompactBytes) studentsDirty = true;
+    }
+
+    static std::string JournalSegmentPath(uint64_t generation) {
+        return "students.journal." + std::to_string(generation);
+    }
+
+    static std::vector<uint64_t> ListJournalSegments() {
+        std::vector<uint64_t> generations;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(".", ec)) {
+            std::string name = entry.path().filename().string();
+            const std::string prefix = "students.journal.";
+            if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+            std::string_view suffix(name.c_str() + prefix.size());
+            if (suffix.find_first_not_of("0123456789") != std::string_view::npos) continue;
+            generations.push_back(std::stoull(std::string(suffix)));
+        }
+        std::sort(generations.begin(), generations.end());
+        return generations;
+    }
+
+    // Queues a journal rotation followed by a snapshot of the roster as it is
+    // now. Both run in order behind any journal records already queued.
+    void QueueStudentSnapshot() {
+        if (studentsUnreadable) return;
+        uint64_t generation = ++snapshotGeneration;
+        journalBytes = 0;
+        persistence.Submit([this, generation] {
+            journal.Close();
+            std::error_code ec;
+            if (std::filesystem::exists("students.journal", ec) &&
+                !Storage::ReplaceFile("students.journal", JournalSegmentPath(journalGeneration)))
+                return false;
+            journalGeneration = generation;
+            return journal.Open("students.journal", generation);
+        }, "journal");
+        persistence.Submit([this, roster = students, generation] { // Shares the columns; see StudentTable
+            // Graduates must be safe in their archive before a roster without them replaces students.db
+            while (!unarchived.empty()) {
+                if (!WriteArchive(unarchived.front().path, unarchived.front().graduates)) return false;
+                unarchived.erase(unarchived.begin());
+            }
+            if (!WriteStudentSnapshot(roster, generation)) return false;
+            snapshotWritten.store(generation, std::memory_order_release);
+            for (uint64_t segment : ListJournalSegments()) {
+                std::error_code ec;
+                if (segment < generation) std::filesystem::remove(JournalSegmentPath(segment), ec);
+            }
+            return true;
+        }, "students");
+    }
+
+    // Applies every intact record of a journal written on top of the loaded
+    // snapshot (or a newer one). Returns the number of records applied.
+    size_t ReplayJournal(const std::string& path, uint64_t minGeneration, uint64_t& generation, size_t& validLength) {
+        Storage::MappedFile file(path);
+        validLength = 0;
+        if (file.size() == 0) return 0;
+
+        std::vector<std::string_view> records;
+        validLength = Storage::ReadJournal(file.view(), generation,
+            [&records](std::string_view payload) { records.push_back(payload); });
+        if (generation < minGeneration) return 0; // Already folded into the snapshot
+
+        size_t applied = 0;
+        for (std::string_view payload : records)
+            if (ApplyJournalRecord(payload)) ++applied;
+        return applied;
+    }
+
+    bool ApplyJournalRecord(std::string_view payload) {
+        Storage::JournalReader in(payload);
+        auto op = static_cast<Storage::JournalOp>(in.Get<uint8_t>());
+        switch (op) {
+            case Storage::JournalOp::PutStudent: {
+                std::optional<Student> s = Storage::DecodePutStudent(in);
+                if (!s) return false;
+                PutStudent(std::move(*s));
+                return true;
+            }
+            case Storage::JournalOp::DeleteStudent: {
+                int id = in.Get<int32_t>();
+                return in.ok() && RemoveStudent(id);
+            }
+            case Storage::JournalOp::SetField: {
+                int id = in.Get<int32_t>();
+                auto field = static_cast<Storage::StudentField>(in.Get<uint8_t>());
+                std::string_view text;
+                float number = 0.0f;
+                if (field == Storage::StudentField::Attendance) number = in.Get<float>();
+                else text = in.GetString();
+                std::optional<StudentTable::Row> s = FindStudent(id);
+                if (!in.ok() || !s) return false;
+                ApplyStudentField(*s, field, text, number);
+                return true;
+            }
+            case Storage::JournalOp::Batch: {
+                bool applied = false;
+                while (in.ok() && !in.AtEnd()) {
+                    std::string_view record = in.GetString();
+                    if (in.ok() && ApplyJournalRecord(record)) applied = true;
+                }
+                return applied;
+            }
+            case Storage::JournalOp::SetMark: {
+                int id = in.Get<int32_t>();
+                int term = in.Get<uint16_t>();
+                std::string_view subject = in.GetString();
+                int mark = in.Get<int32_t>();
+                std::optional<StudentTable::Row> s = FindStudent(id);
+                if (!in.ok() || !s) return false;
+                SetMark(*s, term, SymbolTable::Get().Intern(subject), mark);
+                return true;
+            }
+        }
+        return false;
     }
 };
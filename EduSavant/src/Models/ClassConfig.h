@@ -1,61 +1,180 @@
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
-#include <map>
-#include <algorithm>
-#include <iostream>
+#include "Core/Span.h"
+#include "Core/SymbolTable.h"
 
+// Handles into ClassConfig. An ID stays valid, and keeps naming the same
+// class or section, for as long as the config does (until Clear()), no matter
+// what is added around it.
+using ClassId = int32_t;
+using SectionId = int32_t;
+constexpr ClassId kNoClass = -1;
+constexpr SectionId kNoSection = -1;
+
+// The school's classes (e.g. "10"), their sections ("A", "B") and the
+// subjects each section is taught, kept as flat tables. Classes and sections
+// are stored in the order they were added and addressed by ID; classOrder
+// lists the classes by name, each class owns a contiguous, name-ordered
+// range of sectionOrder, and each section a contiguous range of subjects.
+// Lookups are const, O(1) and never add anything. Every change bumps
+// Generation(), so screens can cache what they derive from the config.
 class ClassConfig {
 public:
-    // Key: Class Name (e.g., "10"), Value: List of Sections (e.g., "A", "B")
-    std::map<std::string, std::vector<std::string>> classesAndSections;
-    
-    // Key: Class Name -> Section Name -> List of Subjects
-    std::map<std::string, std::map<std::string, std::vector<std::string>>> sectionSubjects;
+    struct ClassEntry {
+        std::string name;
+        Symbol symbol = kNoSymbol;
+        uint32_t firstSection = 0; // Range in sectionOrder
+        uint32_t sectionCount = 0;
+    };
+
+    struct SectionEntry {
+        std::string name;
+        Symbol symbol = kNoSymbol;
+        ClassId classId = kNoClass;
+        uint32_t firstSubject = 0; // Range in subjects
+        uint32_t subjectCount = 0;
+    };
 
     static ClassConfig& Get() {
         static ClassConfig instance;
         return instance;
     }
 
-    void AddClass(const std::string& className) {
-        if (classesAndSections.find(className) == classesAndSections.end()) {
-            classesAndSections[className] = std::vector<std::string>(); // Empty sections
-        }
+    uint64_t Generation() const { return generation; }
+
+    // Every class, by name.
+    Span<ClassId> Classes() const { return classOrder; }
+    const ClassEntry& Class(ClassId id) const { return classes[id]; }
+
+    // The class's sections, by name.
+    Span<SectionId> Sections(ClassId id) const {
+        const ClassEntry& c = classes[id];
+        return { sectionOrder.data() + c.firstSection, c.sectionCount };
     }
+    const SectionEntry& Section(SectionId id) const { return sections[id]; }
 
-    void AddSection(const std::string& className, const std::string& sectionName) {
-        if (classesAndSections.find(className) != classesAndSections.end()) {
-            auto& sections = classesAndSections[className];
-            if (std::find(sections.begin(), sections.end(), sectionName) == sections.end()) {
-                sections.push_back(sectionName);
-                std::sort(sections.begin(), sections.end());
-            }
-            // Ensure map entry exists
-            if (sectionSubjects[className].find(sectionName) == sectionSubjects[className].end()) {
-                 sectionSubjects[className][sectionName] = std::vector<std::string>();
-            }
+    // The section's subjects, interned so they key Student marks directly,
+    // in the order they were added.
+    Span<Symbol> Subjects(SectionId id) const {
+        const SectionEntry& s = sections[id];
+        return { subjects.data() + s.firstSubject, s.subjectCount };
+    }
+
+    // kNoClass / kNoSection if not configured.
+    ClassId FindClass(Symbol className) const {
+        auto it = classBySymbol.find(className);
+        return it == classBySymbol.end() ? kNoClass : it->second;
+    }
+    ClassId FindClass(std::string_view className) const { return FindClass(SymbolTable::Get().Find(className)); }
+
+    SectionId FindSection(ClassId cls, Symbol sectionName) const {
+        auto it = sectionByKey.find(Key(cls, sectionName));
+        return it == sectionByKey.end() ? kNoSection : it->second;
+    }
+    SectionId FindSection(ClassId cls, std::string_view sectionName) const {
+        return FindSection(cls, SymbolTable::Get().Find(sectionName));
+    }
+    SectionId FindSection(std::string_view className, std::string_view sectionName) const {
+        return FindSection(FindClass(className), sectionName);
+    }
+
+    // Subjects of a student's class and section; empty if not configured.
+    Span<Symbol> SubjectsOf(Symbol className, Symbol sectionName) const {
+        SectionId id = FindSection(FindClass(className), sectionName);
+        return id == kNoSection ? Span<Symbol>() : Subjects(id);
+    }
+
+    // Adding something that exists already returns its ID and changes nothing.
+    ClassId AddClass(const std::string& className) {
+        Symbol symbol = SymbolTable::Get().Intern(className);
+        if (ClassId found = FindClass(symbol); found != kNoClass) return found;
+
+        auto pos = std::lower_bound(classOrder.begin(), classOrder.end(), className,
+                                    [this](ClassId c, const std::string& name) { return classes[c].name < name; });
+        // An empty section range where the next class's begins
+        uint32_t firstSection = pos == classOrder.end() ? static_cast<uint32_t>(sectionOrder.size())
+                                                        : classes[*pos].firstSection;
+        ClassId id = static_cast<ClassId>(classes.size());
+        classes.push_back({ className, symbol, firstSection, 0 });
+        classOrder.insert(pos, id);
+        classBySymbol.emplace(symbol, id);
+        ++generation;
+        return id;
+    }
+
+    // kNoSection if the class isn't configured.
+    SectionId AddSection(const std::string& className, const std::string& sectionName) {
+        ClassId cls = FindClass(className);
+        if (cls == kNoClass) return kNoSection;
+        Symbol symbol = SymbolTable::Get().Intern(sectionName);
+        if (SectionId found = FindSection(cls, symbol); found != kNoSection) return found;
+
+        ClassEntry& c = classes[cls];
+        auto range = sectionOrder.begin() + c.firstSection;
+        auto pos = std::lower_bound(range, range + c.sectionCount, sectionName,
+                                    [this](SectionId s, const std::string& name) { return sections[s].name < name; });
+        // An empty subject range where the next section's (in any class) begins
+        uint32_t firstSubject = pos == sectionOrder.end() ? static_cast<uint32_t>(subjects.size())
+                                                          : sections[*pos].firstSubject;
+        SectionId id = static_cast<SectionId>(sections.size());
+        sections.push_back({ sectionName, symbol, cls, firstSubject, 0 });
+        sectionOrder.insert(pos, id);
+        ++c.sectionCount;
+        bool after = false;
+        for (ClassId other : classOrder) { // Later classes' ranges move up one
+            if (after) ++classes[other].firstSection;
+            after |= other == cls;
         }
+        sectionByKey.emplace(Key(cls, symbol), id);
+        ++generation;
+        return id;
     }
 
+    // Ignored unless the class and section are configured.
     void AddSubject(const std::string& className, const std::string& sectionName, const std::string& subjectName) {
-         // Ensure class and section exist
-         if (sectionSubjects.find(className) == sectionSubjects.end()) return;
-         
-         auto& secMap = sectionSubjects[className];
-         // Ensure entry for section (auto-created by [])
-         auto& subjects = secMap[sectionName];
-         
-         if (std::find(subjects.begin(), subjects.end(), subjectName) == subjects.end()) {
-            subjects.push_back(subjectName);
-         }
-    }
+        SectionId sec = FindSection(className, sectionName);
+        if (sec == kNoSection) return;
+        Symbol subject = SymbolTable::Get().Intern(subjectName);
+        Span<Symbol> current = Subjects(sec);
+        if (std::find(current.begin(), current.end(), subject) != current.end()) return;
 
-    const std::vector<std::string>& GetSections(const std::string& className) {
-        return classesAndSections[className];
+        SectionEntry& s = sections[sec];
+        subjects.insert(subjects.begin() + s.firstSubject + s.subjectCount, subject);
+        ++s.subjectCount;
+        bool after = false;
+        for (SectionId other : sectionOrder) { // Later sections' ranges move up one
+            if (after) ++sections[other].firstSubject;
+            after |= other == sec;
+        }
+        ++generation;
     }
 
-    const std::vector<std::string>& GetSubjects(const std::string& className, const std::string& sectionName) {
-        return sectionSubjects[className][sectionName];
+    // Forgets every class; IDs handed out before are no longer valid.
+    void Clear() {
+        classes.clear();
+        sections.clear();
+        classOrder.clear();
+        sectionOrder.clear();
+        subjects.clear();
+        classBySymbol.clear();
+        sectionByKey.clear();
+        ++generation;
     }
+
+private:
+    static uint64_t Key(ClassId cls, Symbol section) { return uint64_t(uint32_t(cls)) << 32 | section; }
+
+    std::vector<ClassEntry> classes;     // By ClassId
+    std::vector<SectionEntry> sections;  // By SectionId
+    std::vector<ClassId> classOrder;     // By name
+    std::vector<SectionId> sectionOrder; // By class name, then section name
+    std::vector<Symbol> subjects;        // Grouped in sectionOrder order
+    std::unordered_map<Symbol, ClassId> classBySymbol;
+    std::unordered_map<uint64_t, SectionId> sectionByKey; // (class, section symbol)
+    uint64_t generation = 0;
 };
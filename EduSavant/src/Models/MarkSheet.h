@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+#include "Core/Span.h"
+#include "Core/SymbolTable.h"
+
+// A student's marks as one flat array of subject columns, each holding a
+// score per term. Column order follows the section's subject list in
+// ClassConfig (see Layout), so the profile modal reads a mark by slot in
+// O(1). Subjects outside that list are extra columns at the end.
+class MarkSheet {
+public:
+    static constexpr int kTerms = 4;           // Terms are numbered 1..kTerms
+    static constexpr int kNoMark = INT_MIN;    // Cell never set
+
+    struct Column {
+        Symbol subject = kEmptySymbol;
+        int scores[kTerms] = { kNoMark, kNoMark, kNoMark, kNoMark };
+    };
+
+    // O(1) when slot is the subject's column; otherwise falls back to a scan.
+    // Unset marks read as 0.
+    int Get(int term, Symbol subject, size_t slot) const {
+        if (term < 1 || term > kTerms) return 0;
+        if (slot >= columns.size() || columns[slot].subject != subject) {
+            slot = Find(subject);
+            if (slot == kNoSlot) return 0;
+        }
+        int score = columns[slot].scores[term - 1];
+        return score == kNoMark ? 0 : score;
+    }
+
+    int Get(int term, Symbol subject) const { return Get(term, subject, Find(subject)); }
+
+    // The stored cell, kNoMark if it was never set.
+    int Peek(int term, Symbol subject) const {
+        size_t slot = Find(subject);
+        if (term < 1 || term > kTerms || slot == kNoSlot) return kNoMark;
+        return columns[slot].scores[term - 1];
+    }
+
+    // Same, O(1) when slot is the subject's column (as Get).
+    int Peek(int term, Symbol subject, size_t slot) const {
+        if (term < 1 || term > kTerms) return kNoMark;
+        if (slot >= columns.size() || columns[slot].subject != subject) return Peek(term, subject);
+        return columns[slot].scores[term - 1];
+    }
+
+    // Terms outside 1..kTerms are ignored.
+    void Set(int term, Symbol subject, int score) {
+        if (term < 1 || term > kTerms) return;
+        size_t slot = Find(subject);
+        if (slot == kNoSlot) {
+            slot = columns.size();
+            columns.push_back(Column{ subject });
+        }
+        columns[slot].scores[term - 1] = score;
+    }
+
+    // Reorders columns so subjects[i] is column i; columns for subjects not
+    // in the list keep their relative order after them.
+    void Layout(Span<Symbol> subjects) {
+        if (IsLaidOut(subjects)) return;
+        std::vector<Column> ordered;
+        ordered.reserve(std::max(columns.size(), subjects.size()));
+        for (Symbol sub : subjects) {
+            size_t slot = Find(sub);
+            ordered.push_back(slot == kNoSlot ? Column{ sub } : columns[slot]);
+        }
+        for (const Column& c : columns)
+            if (std::find(subjects.begin(), subjects.end(), c.subject) == subjects.end())
+                ordered.push_back(c);
+        columns = std::move(ordered);
+    }
+
+    // True if subjects[i] is already column i for every i.
+    bool IsLaidOut(Span<Symbol> subjects) const {
+        if (columns.size() < subjects.size()) return false;
+        for (size_t i = 0; i < subjects.size(); ++i)
+            if (columns[i].subject != subjects[i]) return false;
+        return true;
+    }
+
+    // Calls fn(term, subject, score) for every mark that has been set, term by term.
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+        for (int t = 0; t < kTerms; ++t)
+            for (const Column& c : columns)
+                if (c.scores[t] != kNoMark) fn(t + 1, c.subject, c.scores[t]);
+    }
+
+    size_t Count() const {
+        size_t n = 0;
+        for (const Column& c : columns)
+            for (int score : c.scores) n += score != kNoMark;
+        return n;
+    }
+
+private:
+    static constexpr size_t kNoSlot = SIZE_MAX;
+
+    size_t Find(Symbol subject) const {
+        for (size_t i = 0; i < columns.size(); ++i)
+            if (columns[i].subject == subject) return i;
+        return kNoSlot;
+    }
+
+    std::vector<Column> columns;
+};
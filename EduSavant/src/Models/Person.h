@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <iostream>
+#include <utility>
 
 class Person {
 protected:
@@ -11,23 +12,23 @@ protected:
 
 public:
     Person(int id, std::string name, std::string email, std::string phone) 
-        : id(id), name(name), email(email), phone(phone) {}
+        : id(id), name(std::move(name)), email(std::move(email)), phone(std::move(phone)) {}
     
     virtual ~Person() {}
 
     // Getters
     int getId() const { return id; }
-    std::string getName() const { return name; }
-    std::string getEmail() const { return email; }
-    std::string getPhone() const { return phone; }
+    const std::string& getName() const { return name; }
+    const std::string& getEmail() const { return email; }
+    const std::string& getPhone() const { return phone; }
 
     // Setters
-    void setName(const std::string& n) { name = n; }
-    void setEmail(const std::string& e) { email = e; }
-    void setPhone(const std::string& p) { phone = p; }
+    void setName(std::string n) { name = std::move(n); }
+    void setEmail(std::string e) { email = std::move(e); }
+    void setPhone(std::string p) { phone = std::move(p); }
 
     // Virtual function for polymorphism
-    virtual std::string getRole() const = 0;
+    virtual const std::string& getRole() const = 0;
     virtual void displayInfo() const {
         std::cout << "ID: " << id << "\nName: " << name << "\nEmail: " << email << "\nPhone: " << phone << std::endl;
     }
@@ -1,23 +1,26 @@
 #pragma once
 #include "Person.h"
 #include <vector>
+#include "Core/SymbolTable.h"
 
 class Staff : public Person {
 private:
-    std::string role; // e.g., "Principal", "Teacher", "Clerk"
-    std::string subject; // Optional, only for Teachers
-    std::string phone; // Storing phone here as well for now
+    Symbol role; // e.g., "Principal", "Teacher", "Clerk"
+    Symbol subject; // Optional, only for Teachers
 
 public:
-    Staff(int id, std::string name, std::string email, std::string phone, std::string role, std::string subject = "")
-        : Person(id, name, email, phone), role(role), subject(subject), phone(phone) {}
+    // Role and subject are only interned, so they are taken as views
+    Staff(int id, std::string name, std::string email, std::string phone, std::string_view role, std::string_view subject = {})
+        : Person(id, std::move(name), std::move(email), std::move(phone)), role(SymbolTable::Get().Intern(role)),
+          subject(SymbolTable::Get().Intern(subject)) {}
 
-    std::string getRole() const override { return role; }
-    std::string getSubject() const { return subject; }
-    std::string getPhone() const { return phone; }
+    const std::string& getRole() const override { return SymbolTable::Get().Str(role); }
+    const std::string& getSubject() const { return SymbolTable::Get().Str(subject); }
+    Symbol getRoleSymbol() const { return role; }
+    Symbol getSubjectSymbol() const { return subject; }
 
-    void setRole(const std::string& r) { role = r; }
-    void setSubject(const std::string& s) { subject = s; }
+    void setRole(std::string_view r) { role = SymbolTable::Get().Intern(r); }
+    void setSubject(std::string_view s) { subject = SymbolTable::Get().Intern(s); }
 
     void displayInfo() const override {
         // Debug info
@@ -2,62 +2,71 @@
 #include "Person.h"
 #include <vector>
 #include <numeric>
-#include <map> // Added for std::map
+#include "Core/SymbolTable.h"
+#include "MarkSheet.h"
 
 class Student : public Person {
 private:
-    std::string className; // e.g., "10"
-    std::string section;   // e.g., "A"
+    Symbol className; // e.g., "10"
+    Symbol section;   // e.g., "A"
     int rollNumber;
     std::string fatherName;
-    std::string phone; // Moved from Person to Student in this model
     float attendance;
 
-    // Term (1-4) -> Subject -> Mark
-    std::map<int, std::map<std::string, int>> academicRecord;
+    // Term (1-4) x Subject -> Mark
+    MarkSheet marks;
 
 public:
-    Student(int id, std::string name, std::string email, std::string phone, std::string className, std::string section, std::string fatherName)
-        : Person(id, name, email, phone), className(className), section(section), fatherName(fatherName), phone(phone), attendance(0.0f) {
+    Student(int id, std::string name, std::string email, std::string phone, std::string_view className, std::string_view section, std::string fatherName)
+        : Student(id, std::move(name), std::move(email), std::move(phone), SymbolTable::Get().Intern(className),
+                  SymbolTable::Get().Intern(section), std::move(fatherName)) {}
+
+    // For loaders that have already interned the class and section
+    Student(int id, std::string name, std::string email, std::string phone, Symbol className, Symbol section, std::string fatherName)
+        : Person(id, std::move(name), std::move(email), std::move(phone)), className(className), section(section),
+          fatherName(std::move(fatherName)), attendance(0.0f) {
         rollNumber = 0; // Assigned later
     }
 
     // Getters
-    std::string getClassName() const { return className; }
-    std::string getSection() const { return section; }
-    std::string getFatherName() const { return fatherName; }
-    std::string getPhone() const { return phone; }
+    const std::string& getClassName() const { return SymbolTable::Get().Str(className); }
+    const std::string& getSection() const { return SymbolTable::Get().Str(section); }
+    Symbol getClassSymbol() const { return className; }
+    Symbol getSectionSymbol() const { return section; }
+    const std::string& getFatherName() const { return fatherName; }
     int getRollNumber() const { return rollNumber; }
     float getAttendance() const { return attendance; }
 
     // Setters
-    void setName(const std::string& n) { Person::setName(n); } // Expose base setter
-    void setFatherName(const std::string& f) { fatherName = f; }
-    void setPhone(const std::string& p) { phone = p; Person::setPhone(p); } // Update both
-    void setEmail(const std::string& e) { Person::setEmail(e); }
+    void setFatherName(std::string f) { fatherName = std::move(f); }
+    void setClassName(std::string_view c) { className = SymbolTable::Get().Intern(c); }
+    void setSection(std::string_view s) { section = SymbolTable::Get().Intern(s); }
     
     void setRollNumber(int r) { rollNumber = r; }
     void setAttendance(float a) { attendance = a; }
 
-    void setMark(int term, const std::string& subject, int mark) {
-        academicRecord[term][subject] = mark;
+    void setMark(int term, Symbol subject, int mark) { marks.Set(term, subject, mark); }
+    void setMark(int term, std::string_view subject, int mark) {
+        setMark(term, SymbolTable::Get().Intern(subject), mark);
     }
 
-    int getMark(int term, const std::string& subject) {
-        if (academicRecord.count(term) && academicRecord[term].count(subject)) {
-            return academicRecord[term][subject];
-        }
-        return 0; // Default if not found
-    }
+    // slot is the subject's index in its section's subject list (O(1) read)
+    int getMark(int term, Symbol subject, size_t slot) const { return marks.Get(term, subject, slot); }
+    int getMark(int term, Symbol subject) const { return marks.Get(term, subject); } // 0 if not found
+
+    // Lines the mark columns up with the section's subject list.
+    void layoutMarks(Span<Symbol> subjects) { marks.Layout(subjects); }
     
     // Virtual implementations
-    std::string getRole() const override { return "Student"; }
+    const std::string& getRole() const override {
+        static const std::string role = "Student";
+        return role;
+    }
 
     void displayInfo() const override {
         // Debug
     }
 
     // For persistence helper
-    const std::map<int, std::map<std::string, int>>& getAcademicRecord() const { return academicRecord; }
-    void loadAcademicRecord(const std::map<int, std::map<std::string, int>>& record) { academicRecord = record; }
+    const MarkSheet& getMarks() const { return marks; }
 };
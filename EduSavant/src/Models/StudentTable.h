@@ -0,0 +1,246 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Core/CowColumn.h"
+#include "Core/SymbolTable.h"
+#include "MarkSheet.h"
+#include "Student.h"
+
+// The roster stored column by column: one contiguous array per field, all
+// indexed by slot. Scans over a single field (attendance for the dashboard,
+// class/section for grouping, names for roll order) touch only that field's
+// memory. Row and ConstRow are lightweight (table, slot) views with the same
+// getters and setters as Student, for code that works one student at a time.
+// Columns are copy-on-write (see CowColumn), so copying the table is cheap
+// and the copy is an immutable snapshot a background thread can read while
+// this one keeps editing.
+class StudentTable {
+public:
+    class ConstRow {
+    public:
+        ConstRow(const StudentTable* table, int slot) : table(table), index(slot) {}
+
+        int slot() const { return index; }
+        int getId() const { return table->ids[index]; }
+        const std::string& getName() const { return table->names[index]; }
+        const std::string& getEmail() const { return table->emails[index]; }
+        const std::string& getPhone() const { return table->phones[index]; }
+        const std::string& getFatherName() const { return table->fatherNames[index]; }
+        const std::string& getClassName() const { return SymbolTable::Get().Str(table->classNames[index]); }
+        const std::string& getSection() const { return SymbolTable::Get().Str(table->sections[index]); }
+        Symbol getClassSymbol() const { return table->classNames[index]; }
+        Symbol getSectionSymbol() const { return table->sections[index]; }
+        int getRollNumber() const { return table->rollNumbers[index]; }
+        float getAttendance() const { return table->attendance[index]; }
+
+        int getMark(int term, Symbol subject, size_t slot) const { return table->marks[index].Get(term, subject, slot); }
+        int getMark(int term, Symbol subject) const { return table->marks[index].Get(term, subject); }
+        const MarkSheet& getMarks() const { return table->marks[index]; }
+
+        // Copies the row out as a standalone Student.
+        Student ToStudent() const {
+            Student s(getId(), getName(), getEmail(), getPhone(), getClassSymbol(), getSectionSymbol(), getFatherName());
+            s.setRollNumber(getRollNumber());
+            s.setAttendance(getAttendance());
+            getMarks().ForEach([&s](int term, Symbol subject, int mark) { s.setMark(term, subject, mark); });
+            return s;
+        }
+
+    private:
+        const StudentTable* table;
+
+    protected:
+        int index;
+    };
+
+    class Row : public ConstRow {
+    public:
+        Row(StudentTable* table, int slot) : ConstRow(table, slot), table(table) {}
+
+        void setName(std::string n) { table->names.Mutable(index) = std::move(n); }
+        void setEmail(std::string e) { table->emails.Mutable(index) = std::move(e); }
+        void setPhone(std::string p) { table->phones.Mutable(index) = std::move(p); }
+        void setFatherName(std::string f) { table->fatherNames.Mutable(index) = std::move(f); }
+        void setClassName(std::string_view c) { table->classNames.Mutable(index) = SymbolTable::Get().Intern(c); }
+        void setSection(std::string_view s) { table->sections.Mutable(index) = SymbolTable::Get().Intern(s); }
+        void setPlacement(Symbol className, Symbol section) {
+            table->classNames.Mutable(index) = className;
+            table->sections.Mutable(index) = section;
+        }
+        void setRollNumber(int r) {
+            if (table->rollNumbers[index] != r) table->rollNumbers.Mutable(index) = r; // Renumbering rewrites mostly unchanged values
+        }
+        void setAttendance(float a) { table->attendance.Mutable(index) = a; }
+        void setMark(int term, Symbol subject, int mark) { table->marks.Mutable(index).Set(term, subject, mark); }
+        void layoutMarks(Span<Symbol> subjects) {
+            if (!table->marks[index].IsLaidOut(subjects)) table->marks.Mutable(index).Layout(subjects);
+        }
+        void clearMarks() { table->marks.Mutable(index) = MarkSheet(); }
+
+    private:
+        StudentTable* table;
+    };
+
+    size_t size() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    Row operator[](int slot) { return Row(this, slot); }
+    ConstRow operator[](int slot) const { return ConstRow(this, slot); }
+
+    // Appends a row with no marks and roll number 0; returns it for filling in.
+    Row Append(int id, std::string name, std::string email, std::string phone,
+               Symbol className, Symbol section, std::string fatherName) {
+        ids.push_back(id);
+        rollNumbers.push_back(0);
+        attendance.push_back(0.0f);
+        classNames.push_back(className);
+        sections.push_back(section);
+        names.push_back(std::move(name));
+        emails.push_back(std::move(email));
+        phones.push_back(std::move(phone));
+        fatherNames.push_back(std::move(fatherName));
+        marks.push_back(MarkSheet());
+        return Row(this, static_cast<int>(ids.size()) - 1);
+    }
+
+    Row Append(const Student& s) {
+        Row row = Append(s.getId(), s.getName(), s.getEmail(), s.getPhone(),
+                         s.getClassSymbol(), s.getSectionSymbol(), s.getFatherName());
+        row.setRollNumber(s.getRollNumber());
+        row.setAttendance(s.getAttendance());
+        marks.Mutable(row.slot()) = s.getMarks();
+        return row;
+    }
+
+    // Appends row `slot` of another table under the given ID, moving its
+    // text and marks out of the source.
+    Row Take(StudentTable& from, int slot, int id) {
+        Row row = Append(id, std::move(from.names.Mutable(slot)), std::move(from.emails.Mutable(slot)),
+                         std::move(from.phones.Mutable(slot)), from.classNames[slot], from.sections[slot],
+                         std::move(from.fatherNames.Mutable(slot)));
+        row.setRollNumber(from.rollNumbers[slot]);
+        row.setAttendance(from.attendance[slot]);
+        marks.Mutable(row.slot()) = std::move(from.marks.Mutable(slot));
+        return row;
+    }
+
+    // Appends every row of another table, in order.
+    void AppendAll(StudentTable&& other) {
+        Extend(ids, other.ids);
+        Extend(rollNumbers, other.rollNumbers);
+        Extend(attendance, other.attendance);
+        Extend(classNames, other.classNames);
+        Extend(sections, other.sections);
+        Extend(names, other.names);
+        Extend(emails, other.emails);
+        Extend(phones, other.phones);
+        Extend(fatherNames, other.fatherNames);
+        Extend(marks, other.marks);
+        other.clear();
+    }
+
+    // Overwrites every field of a row.
+    void Assign(int slot, const Student& s) {
+        ids.Mutable(slot) = s.getId();
+        rollNumbers.Mutable(slot) = s.getRollNumber();
+        attendance.Mutable(slot) = s.getAttendance();
+        classNames.Mutable(slot) = s.getClassSymbol();
+        sections.Mutable(slot) = s.getSectionSymbol();
+        names.Mutable(slot) = s.getName();
+        emails.Mutable(slot) = s.getEmail();
+        phones.Mutable(slot) = s.getPhone();
+        fatherNames.Mutable(slot) = s.getFatherName();
+        marks.Mutable(slot) = s.getMarks();
+    }
+
+    // Takes the roll numbers of a copy of this table that was renumbered
+    // elsewhere (e.g. off-thread); both must hold the same rows in the same slots.
+    void AdoptRollNumbers(const StudentTable& copy) { rollNumbers = copy.rollNumbers; }
+
+    // Moves row `from` over row `to` (the first half of a swap-and-pop).
+    void MoveRow(int from, int to) {
+        Move(ids, from, to);
+        Move(rollNumbers, from, to);
+        Move(attendance, from, to);
+        Move(classNames, from, to);
+        Move(sections, from, to);
+        Move(names, from, to);
+        Move(emails, from, to);
+        Move(phones, from, to);
+        Move(fatherNames, from, to);
+        Move(marks, from, to);
+    }
+
+    void PopBack() {
+        ids.pop_back();
+        rollNumbers.pop_back();
+        attendance.pop_back();
+        classNames.pop_back();
+        sections.pop_back();
+        names.pop_back();
+        emails.pop_back();
+        phones.pop_back();
+        fatherNames.pop_back();
+        marks.pop_back();
+    }
+
+    void clear() {
+        ids.clear();
+        rollNumbers.clear();
+        attendance.clear();
+        classNames.clear();
+        sections.clear();
+        names.clear();
+        emails.clear();
+        phones.clear();
+        fatherNames.clear();
+        marks.clear();
+    }
+
+    void reserve(size_t n) {
+        ids.reserve(n);
+        rollNumbers.reserve(n);
+        attendance.reserve(n);
+        classNames.reserve(n);
+        sections.reserve(n);
+        names.reserve(n);
+        emails.reserve(n);
+        phones.reserve(n);
+        fatherNames.reserve(n);
+        marks.reserve(n);
+    }
+
+    // Read-only columns for scans and aggregates
+    const CowColumn<int>& Ids() const { return ids; }
+    const CowColumn<int>& RollNumbers() const { return rollNumbers; }
+    const CowColumn<float>& Attendance() const { return attendance; }
+    const CowColumn<Symbol>& ClassNames() const { return classNames; }
+    const CowColumn<Symbol>& Sections() const { return sections; }
+    const CowColumn<std::string>& Names() const { return names; }
+    const CowColumn<MarkSheet>& Marks() const { return marks; }
+
+private:
+    template <typename T>
+    static void Extend(CowColumn<T>& to, CowColumn<T>& from) {
+        to.reserve(to.size() + from.size());
+        for (size_t i = 0; i < from.size(); ++i) to.push_back(std::move(from.Mutable(i)));
+    }
+
+    template <typename T>
+    static void Move(CowColumn<T>& column, int from, int to) {
+        column.Mutable(to) = std::move(column.Mutable(from));
+    }
+
+    CowColumn<int> ids;
+    CowColumn<int> rollNumbers;
+    CowColumn<float> attendance;
+    CowColumn<Symbol> classNames;
+    CowColumn<Symbol> sections;
+    CowColumn<std::string> names;
+    CowColumn<std::string> emails;
+    CowColumn<std::string> phones;
+    CowColumn<std::string> fatherNames;
+    CowColumn<MarkSheet> marks;
+};
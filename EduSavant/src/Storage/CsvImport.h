@@ -0,0 +1,406 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Core/SymbolTable.h"
+#include "Models/ClassConfig.h"
+#include "Models/MarkSheet.h"
+#include "Models/StudentTable.h"
+#include "Storage/MappedFile.h"
+
+namespace Storage {
+
+// Bulk student import from a CSV file with a header row naming the columns:
+//
+//   id,name,father_name,email,phone,class,section,attendance,T1:Maths,T2:Maths,...
+//
+// Column names are case-insensitive and may come in any order. name, class
+// and section are required; an empty or missing id means "assign a new one".
+// Mark columns are T<term>:<subject>. Fields may be double-quoted ("" is a
+// literal quote) but may not span lines. Unknown columns are ignored.
+//
+// The file is memory-mapped and split at line boundaries into chunks that
+// worker threads parse in parallel. Every row is validated against a copy of
+// ClassConfig taken at the start (class and section must exist, marked
+// subjects must be taught in that section, marks and attendance 0-100); rows
+// with a problem are skipped and reported by line. Nothing here touches
+// DataManager: once Finished(), the UI thread hands Rows() to
+// DataManager::BeginImport.
+struct CsvIssue {
+    size_t line; // 1-based, counting the header
+    std::string message;
+};
+
+class CsvStudentImport {
+public:
+    static constexpr size_t kMaxIssues = 1000; // Kept for display; IssueCount() has them all
+
+    // Starts parsing on a background thread. onFinished runs on that thread.
+    CsvStudentImport(std::string path, const ClassConfig& config, std::function<void()> onFinished = {})
+        : path(std::move(path)), onFinished(std::move(onFinished)) {
+        for (ClassId classId : config.Classes()) {
+            ClassRule& cls = classes[config.Class(classId).name];
+            cls.symbol = config.Class(classId).symbol;
+            for (SectionId sectionId : config.Sections(classId)) {
+                SectionRule& sec = cls.sections[config.Section(sectionId).name];
+                sec.symbol = config.Section(sectionId).symbol;
+                Span<Symbol> subjects = config.Subjects(sectionId);
+                sec.subjects.assign(subjects.begin(), subjects.end());
+            }
+        }
+        coordinator = std::thread([this] { Run(); });
+    }
+
+    ~CsvStudentImport() {
+        Cancel();
+        coordinator.join();
+    }
+
+    CsvStudentImport(const CsvStudentImport&) = delete;
+    CsvStudentImport& operator=(const CsvStudentImport&) = delete;
+
+    void Cancel() { cancelled = true; }
+    bool Cancelled() const { return cancelled; }
+    bool Finished() const { return finished.load(std::memory_order_acquire); }
+
+    float Progress() const { return totalBytes ? float(double(bytesDone) / double(totalBytes)) : 0.0f; }
+    size_t RowsParsed() const { return rowsParsed; }
+    const std::string& Path() const { return path; }
+
+    // Everything below is only valid once Finished().
+    // A problem with the file as a whole (unreadable, bad header); empty if none.
+    const std::string& Failure() const { return failure; }
+    StudentTable& Rows() { return rows; }
+    const std::vector<CsvIssue>& Issues() const { return issues; }
+    size_t IssueCount() const { return issueCount; }
+    double Seconds() const { return seconds; }
+
+private:
+    enum class Field { Ignored, Id, Name, FatherName, Email, Phone, Class, Section, Attendance, Mark };
+
+    struct Column {
+        Field field = Field::Ignored;
+        int term = 0;
+        Symbol subject = kEmptySymbol;
+    };
+
+    struct SectionRule {
+        Symbol symbol = kEmptySymbol;
+        std::vector<Symbol> subjects;
+    };
+
+    struct ClassRule {
+        Symbol symbol = kEmptySymbol;
+        std::map<std::string, SectionRule, std::less<>> sections;
+    };
+
+    struct Chunk {
+        std::string_view text;
+        StudentTable rows;
+        std::vector<CsvIssue> issues; // Lines counted from the chunk start
+        size_t issueCount = 0;
+        size_t lines = 0;
+    };
+
+    // Reused per worker so quoted fields don't allocate per row.
+    struct Scratch {
+        struct Unquoted { size_t field, offset, length; };
+        std::vector<std::string_view> fields;
+        std::string unquoted;            // The line's ""-escaped fields, unescaped, back to back
+        std::vector<Unquoted> unquotedAt; // Where each one sits in unquoted
+    };
+
+    static constexpr size_t kChunkBytes = 1u << 20;
+    static constexpr size_t kProgressEvery = 1024; // Lines between progress updates
+
+    void Run() {
+        auto start = std::chrono::steady_clock::now();
+        Parse();
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        finished.store(true, std::memory_order_release);
+        if (onFinished) onFinished();
+    }
+
+    void Parse() {
+        MappedFile file;
+        if (!file.Open(path)) {
+            failure = "Could not open " + path;
+            return;
+        }
+        std::string_view text = file.view();
+        if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) text.remove_prefix(3); // UTF-8 BOM
+        totalBytes = text.size();
+
+        size_t eol = text.find('\n');
+        std::string_view header = text.substr(0, eol);
+        if (!header.empty() && header.back() == '\r') header.remove_suffix(1);
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        if (!ParseHeader(header)) return;
+
+        // Line-aligned chunks, parsed by as many workers as there are cores
+        std::vector<Chunk> chunks;
+        while (!text.empty()) {
+            size_t end = std::min(text.size(), kChunkBytes);
+            size_t nl = text.find('\n', end - 1);
+            end = nl == std::string_view::npos ? text.size() : nl + 1;
+            chunks.emplace_back().text = text.substr(0, end);
+            text.remove_prefix(end);
+        }
+        bytesDone = totalBytes - std::accumulate(chunks.begin(), chunks.end(), size_t(0),
+                                                 [](size_t n, const Chunk& c) { return n + c.text.size(); });
+
+        std::atomic<size_t> next{0};
+        auto work = [&] {
+            Scratch scratch;
+            for (size_t i; (i = next++) < chunks.size() && !cancelled;) ParseChunk(chunks[i], scratch);
+        };
+        unsigned threadCount = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(),
+                                                               static_cast<unsigned>(chunks.size())));
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threadCount; ++t) workers.emplace_back(work);
+        work();
+        for (std::thread& t : workers) t.join();
+        if (cancelled) return;
+
+        // Stitch the chunks together in file order
+        size_t total = 0;
+        for (const Chunk& c : chunks) total += c.rows.size();
+        rows.reserve(total);
+        size_t linesBefore = 1; // The header
+        for (Chunk& c : chunks) {
+            rows.AppendAll(std::move(c.rows));
+            for (CsvIssue& issue : c.issues) {
+                if (issues.size() == kMaxIssues) break;
+                issue.line += linesBefore;
+                issues.push_back(std::move(issue));
+            }
+            issueCount += c.issueCount;
+            linesBefore += c.lines;
+        }
+    }
+
+    bool ParseHeader(std::string_view header) {
+        Scratch scratch;
+        SplitLine(header, scratch);
+        bool seen[int(Field::Mark)] = {};
+        for (std::string_view raw : scratch.fields) {
+            std::string name = Lower(Trim(raw));
+            Column col;
+            if (name == "id") col.field = Field::Id;
+            else if (name == "name") col.field = Field::Name;
+            else if (name == "father_name" || name == "father") col.field = Field::FatherName;
+            else if (name == "email") col.field = Field::Email;
+            else if (name == "phone") col.field = Field::Phone;
+            else if (name == "class") col.field = Field::Class;
+            else if (name == "section") col.field = Field::Section;
+            else if (name == "attendance") col.field = Field::Attendance;
+            else if (name.size() > 3 && name[0] == 't' && name[1] >= '1' && name[1] <= '0' + MarkSheet::kTerms && name[2] == ':') {
+                col.field = Field::Mark;
+                col.term = name[1] - '0';
+                col.subject = SymbolTable::Get().Intern(Trim(raw.substr(raw.find(':') + 1))); // Keep the subject's case
+            }
+            if (col.field != Field::Ignored && col.field != Field::Mark) {
+                if (seen[int(col.field)]) {
+                    failure = "Column \"" + name + "\" appears twice in the header";
+                    return false;
+                }
+                seen[int(col.field)] = true;
+            }
+            columns.push_back(col);
+        }
+        if (!seen[int(Field::Name)] || !seen[int(Field::Class)] || !seen[int(Field::Section)]) {
+            failure = "The header row must have name, class and section columns";
+            return false;
+        }
+        return true;
+    }
+
+    void ParseChunk(Chunk& chunk, Scratch& scratch) {
+        std::string_view text = chunk.text;
+        size_t consumed = 0;
+        while (!text.empty()) {
+            size_t eol = text.find('\n');
+            std::string_view line = text.substr(0, eol);
+            size_t length = eol == std::string_view::npos ? text.size() : eol + 1;
+            text.remove_prefix(length);
+            consumed += length;
+            ++chunk.lines;
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (!line.empty()) ParseRow(line, chunk, scratch);
+
+            if (chunk.lines % kProgressEvery == 0) {
+                bytesDone += consumed;
+                consumed = 0;
+                if (cancelled) return;
+            }
+        }
+        bytesDone += consumed;
+        rowsParsed += chunk.rows.size();
+    }
+
+    void ParseRow(std::string_view line, Chunk& chunk, Scratch& scratch) {
+        auto reject = [&](std::string message) {
+            if (chunk.issues.size() < kMaxIssues) chunk.issues.push_back({ chunk.lines, std::move(message) });
+            ++chunk.issueCount;
+        };
+        if (!SplitLine(line, scratch)) return reject("Unterminated quoted field");
+        const std::vector<std::string_view>& fields = scratch.fields;
+        if (fields.size() != columns.size())
+            return reject("Expected " + std::to_string(columns.size()) + " fields, found " + std::to_string(fields.size()));
+
+        std::string_view text[int(Field::Mark)];
+        for (size_t i = 0; i < columns.size(); ++i)
+            if (columns[i].field != Field::Mark && columns[i].field != Field::Ignored) text[int(columns[i].field)] = Trim(fields[i]);
+
+        int id = 0;
+        if (!text[int(Field::Id)].empty() && (!ParseNumber(text[int(Field::Id)], id) || id <= 0))
+            return reject("Invalid id \"" + std::string(text[int(Field::Id)]) + "\"");
+        if (text[int(Field::Name)].empty()) return reject("Name is empty");
+
+        auto cls = classes.find(text[int(Field::Class)]);
+        if (cls == classes.end()) return reject("Unknown class \"" + std::string(text[int(Field::Class)]) + "\"");
+        auto sec = cls->second.sections.find(text[int(Field::Section)]);
+        if (sec == cls->second.sections.end())
+            return reject("Class " + cls->first + " has no section \"" + std::string(text[int(Field::Section)]) + "\"");
+        const SectionRule& rule = sec->second;
+
+        float attendance = 0.0f;
+        if (!text[int(Field::Attendance)].empty() &&
+            (!ParseFloat(text[int(Field::Attendance)], attendance) || attendance < 0.0f || attendance > 100.0f))
+            return reject("Attendance must be a number from 0 to 100");
+
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i].field != Field::Mark) continue;
+            std::string_view cell = Trim(fields[i]);
+            if (cell.empty()) continue;
+            int mark = 0;
+            if (!ParseNumber(cell, mark) || mark < 0 || mark > 100)
+                return reject("Mark for " + std::string(SymbolTable::Get().View(columns[i].subject)) + " must be 0-100");
+            if (std::find(rule.subjects.begin(), rule.subjects.end(), columns[i].subject) == rule.subjects.end())
+                return reject(std::string(SymbolTable::Get().View(columns[i].subject)) + " is not taught in " +
+                              cls->first + "-" + sec->first);
+        }
+
+        StudentTable::Row row = chunk.rows.Append(id, std::string(text[int(Field::Name)]), std::string(text[int(Field::Email)]),
+                                                  std::string(text[int(Field::Phone)]), cls->second.symbol, rule.symbol,
+                                                  std::string(text[int(Field::FatherName)]));
+        row.setAttendance(attendance);
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i].field != Field::Mark) continue;
+            int mark = 0;
+            if (ParseNumber(Trim(fields[i]), mark)) row.setMark(columns[i].term, columns[i].subject, mark);
+        }
+        row.layoutMarks(rule.subjects);
+    }
+
+    // Splits one CSV line into scratch.fields. Quoted fields with "" escapes
+    // are unescaped into scratch.unquoted, and their views are only taken
+    // once the whole line is split, since appending may move the buffer.
+    // False on an unterminated quote.
+    static bool SplitLine(std::string_view line, Scratch& scratch) {
+        scratch.fields.clear();
+        scratch.unquoted.clear();
+        scratch.unquotedAt.clear();
+        if (!SplitFields(line, scratch)) return false;
+        for (const Scratch::Unquoted& u : scratch.unquotedAt)
+            scratch.fields[u.field] = std::string_view(scratch.unquoted).substr(u.offset, u.length);
+        return true;
+    }
+
+    static bool SplitFields(std::string_view line, Scratch& scratch) {
+        for (;;) {
+            if (!line.empty() && line.front() == '"') {
+                size_t close = 1;
+                bool escaped = false;
+                for (;; ++close) {
+                    close = line.find('"', close);
+                    if (close == std::string_view::npos) return false;
+                    if (close + 1 < line.size() && line[close + 1] == '"') { escaped = true; ++close; continue; }
+                    break;
+                }
+                std::string_view inner = line.substr(1, close - 1);
+                if (escaped) {
+                    std::string& out = scratch.unquoted;
+                    size_t offset = out.size();
+                    for (size_t i = 0; i < inner.size(); ++i) {
+                        out.push_back(inner[i]);
+                        if (inner[i] == '"') ++i; // Skip the second quote of ""
+                    }
+                    scratch.unquotedAt.push_back({ scratch.fields.size(), offset, out.size() - offset });
+                    inner = {}; // Filled in by SplitLine
+                }
+                scratch.fields.push_back(inner);
+                line.remove_prefix(close + 1);
+                size_t comma = line.find(',');
+                if (comma == std::string_view::npos) return true; // Anything after the quote is ignored
+                line.remove_prefix(comma + 1);
+            } else {
+                size_t comma = line.find(',');
+                scratch.fields.push_back(line.substr(0, comma));
+                if (comma == std::string_view::npos) return true;
+                line.remove_prefix(comma + 1);
+            }
+        }
+    }
+
+    static std::string_view Trim(std::string_view s) {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t')) s.remove_suffix(1);
+        return s;
+    }
+
+    static std::string Lower(std::string_view s) {
+        std::string out(s);
+        for (char& c : out) if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        return out;
+    }
+
+    static bool ParseNumber(std::string_view s, int& value) {
+        auto [end, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+        return ec == std::errc() && end == s.data() + s.size();
+    }
+
+    // strtof needs a terminated string; attendance values are short. Only
+    // finite decimal numbers count: strtof also takes "nan", "inf" and hex,
+    // and a NaN would pass every range check after it.
+    static bool ParseFloat(std::string_view s, float& value) {
+        char buf[32];
+        if (s.size() >= sizeof(buf) || s.find_first_of("xX") != std::string_view::npos) return false;
+        std::copy(s.begin(), s.end(), buf);
+        buf[s.size()] = '\0';
+        char* end = nullptr;
+        value = std::strtof(buf, &end);
+        return end == buf + s.size() && std::isfinite(value);
+    }
+
+    std::string path;
+    std::function<void()> onFinished;
+    std::map<std::string, ClassRule, std::less<>> classes;
+    std::vector<Column> columns;
+
+    std::atomic<bool> cancelled{false};
+    std::atomic<bool> finished{false};
+    std::atomic<size_t> totalBytes{0};
+    std::atomic<size_t> bytesDone{0};
+    std::atomic<size_t> rowsParsed{0};
+
+    std::string failure;
+    StudentTable rows;
+    std::vector<CsvIssue> issues;
+    size_t issueCount = 0;
+    double seconds = 0.0;
+
+    std::thread coordinator; // Declared last so it starts after the members above
+};
+
+} // namespace Storage
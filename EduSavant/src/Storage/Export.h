@@ -0,0 +1,429 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Core/Profiler.h"
+#include "Models/MarkSheet.h"
+#include "Models/Staff.h"
+#include "Storage/StudentBinary.h"
+
+namespace Storage {
+
+// Streaming CSV/JSON export. Students and marks are read straight from a
+// mapped students.db snapshot and written through a fixed-size buffer, so an
+// export never holds more than one block of output (plus a slot index for
+// ordering) no matter how large the roster is. Numbers go through to_chars;
+// nothing is formatted with iostreams or built up as a whole-file string.
+//
+// DataManager::Export runs these on the persistence thread, right behind a
+// snapshot of the roster as it was when the export was requested, and only
+// once that snapshot is on disk.
+
+enum class ExportDataset { Students, Marks, Staff };
+enum class ExportFormat { Csv, Json };
+
+struct ExportOptions {
+    ExportDataset dataset = ExportDataset::Students;
+    ExportFormat format = ExportFormat::Csv;
+    std::string path;
+    std::string className; // Empty = every class
+    std::string section;   // Empty = every section of the class
+    int term = 0;          // 0 = every term
+};
+
+// Shared between the UI and the exporting thread. The exporter sets `error`
+// (if any) before publishing `finished`.
+struct ExportProgress {
+    std::atomic<size_t> done{0};
+    std::atomic<size_t> total{0};
+    std::atomic<bool> cancel{false};
+    std::atomic<bool> finished{false};
+    std::string error;
+    size_t rows = 0; // Rows written; valid once finished
+
+    float Fraction() const { return total ? float(double(done) / double(total)) : 0.0f; }
+};
+
+// Appends into a fixed buffer and writes it out a block at a time.
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::string& path) : file(std::fopen(path.c_str(), "wb")) {}
+    ~BufferedWriter() { Close(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    bool ok() const { return file != nullptr && !failed; }
+
+    void Put(char c) {
+        if (used == kBufferSize) Drain();
+        buffer[used++] = c;
+    }
+
+    void Put(std::string_view s) {
+        while (!s.empty()) {
+            if (used == kBufferSize) Drain();
+            size_t n = std::min(s.size(), kBufferSize - used);
+            std::memcpy(buffer + used, s.data(), n);
+            used += n;
+            s.remove_prefix(n);
+        }
+    }
+
+    template <typename Number>
+    void PutNumber(Number value) {
+        if (kBufferSize - used < kMaxNumberChars) Drain();
+        auto [end, ec] = std::to_chars(buffer + used, buffer + kBufferSize, value);
+        if (ec == std::errc()) used = end - buffer;
+    }
+
+    // Flushes and closes; false if anything failed to write.
+    bool Close() {
+        if (!file) return false;
+        Drain();
+        bool ok = std::fclose(file) == 0 && !failed;
+        file = nullptr;
+        failed = !ok;
+        return ok;
+    }
+
+private:
+    static constexpr size_t kBufferSize = 64 * 1024;
+    static constexpr size_t kMaxNumberChars = 64;
+
+    void Drain() {
+        if (file && used > 0 && std::fwrite(buffer, 1, used, file) != used) failed = true;
+        Profiler::CountBytesWritten(used);
+        used = 0;
+    }
+
+    FILE* file;
+    bool failed = false;
+    size_t used = 0;
+    char buffer[kBufferSize];
+};
+
+// Quotes a CSV field only when it needs it.
+inline void PutCsv(BufferedWriter& out, std::string_view s) {
+    if (s.find_first_of(",\"\r\n") == std::string_view::npos) {
+        out.Put(s);
+        return;
+    }
+    out.Put('"');
+    for (char c : s) {
+        if (c == '"') out.Put('"');
+        out.Put(c);
+    }
+    out.Put('"');
+}
+
+inline void PutJson(BufferedWriter& out, std::string_view s) {
+    static const char kHex[] = "0123456789abcdef";
+    out.Put('"');
+    for (char c : s) {
+        switch (c) {
+            case '"':  out.Put("\\\""); break;
+            case '\\': out.Put("\\\\"); break;
+            case '\n': out.Put("\\n"); break;
+            case '\r': out.Put("\\r"); break;
+            case '\t': out.Put("\\t"); break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out.Put("\\u00");
+                    out.Put(kHex[(c >> 4) & 0xF]);
+                    out.Put(kHex[c & 0xF]);
+                } else {
+                    out.Put(c);
+                }
+        }
+    }
+    out.Put('"');
+}
+
+// Writes the `key` part of a JSON member, with the comma before it if needed.
+inline void PutJsonKey(BufferedWriter& out, std::string_view key, bool first = false) {
+    if (!first) out.Put(',');
+    out.Put('"');
+    out.Put(key);
+    out.Put("\":");
+}
+
+namespace detail {
+
+// A validated, mapped students.db: every offset was checked on construction.
+struct StudentDbView {
+    std::string_view table;
+    const char* recordBase = nullptr;
+    const char* markBase = nullptr;
+    uint32_t recordCount = 0;
+    uint32_t markCount = 0;
+
+    bool Open(std::string_view bytes) {
+        StudentDbHeader h;
+        if (!ReadStudentDbHeader(bytes, h)) return false;
+        table = bytes.substr(h.stringsOffset, h.stringsSize);
+        recordBase = bytes.data() + h.recordsOffset;
+        markBase = bytes.data() + h.marksOffset;
+        recordCount = h.recordCount;
+        markCount = h.markCount;
+        return true;
+    }
+
+    StudentDbRecord Record(uint32_t i) const {
+        StudentDbRecord r;
+        std::memcpy(&r, recordBase + size_t(i) * sizeof(r), sizeof(r));
+        return r;
+    }
+
+    StudentDbMark Mark(uint32_t i) const {
+        StudentDbMark m;
+        std::memcpy(&m, markBase + size_t(i) * sizeof(m), sizeof(m));
+        return m;
+    }
+
+    // Bad offsets read as empty strings rather than aborting the export.
+    std::string_view Str(uint32_t offset) const {
+        std::string_view s;
+        return ReadDbString(table, offset, s) ? s : std::string_view();
+    }
+
+    bool MarksInRange(const StudentDbRecord& r) const { return uint64_t(r.markFirst) + r.markCount <= markCount; }
+};
+
+// Records passing the class/section filter, in class, section, roll order.
+inline std::vector<uint32_t> SelectStudents(const StudentDbView& db, const ExportOptions& options) {
+    std::vector<uint32_t> order;
+    for (uint32_t i = 0; i < db.recordCount; ++i) {
+        StudentDbRecord r = db.Record(i);
+        if (!options.className.empty() && db.Str(r.className) != options.className) continue;
+        if (!options.section.empty() && db.Str(r.section) != options.section) continue;
+        order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [&db](uint32_t a, uint32_t b) {
+        StudentDbRecord x = db.Record(a), y = db.Record(b);
+        // Interned strings are stored once, so equal offsets mean equal text
+        if (x.className != y.className) return db.Str(x.className) < db.Str(y.className);
+        if (x.section != y.section) return db.Str(x.section) < db.Str(y.section);
+        if (x.rollNumber != y.rollNumber) return x.rollNumber < y.rollNumber;
+        return x.id < y.id;
+    });
+    return order;
+}
+
+inline void WriteStudents(BufferedWriter& out, const StudentDbView& db, const std::vector<uint32_t>& order,
+                          const ExportOptions& options, ExportProgress& progress) {
+    bool csv = options.format == ExportFormat::Csv;
+
+    // CSV gets one column per term/subject that occurs in the selection,
+    // named like the importer expects (T1:Maths)
+    struct MarkColumn { uint16_t term; uint32_t subject; };
+    std::vector<MarkColumn> columns;
+    std::unordered_map<uint64_t, size_t> columnOf; // term << 32 | subject offset
+    auto key = [](uint16_t term, uint32_t subject) { return (uint64_t(term) << 32) | subject; };
+    if (csv) {
+        for (uint32_t i : order) {
+            StudentDbRecord r = db.Record(i);
+            if (!db.MarksInRange(r)) continue;
+            for (uint32_t m = r.markFirst; m < r.markFirst + r.markCount; ++m) {
+                StudentDbMark mark = db.Mark(m);
+                if (options.term && mark.term != options.term) continue;
+                if (columnOf.emplace(key(mark.term, mark.subject), 0).second) columns.push_back({ mark.term, mark.subject });
+            }
+        }
+        std::sort(columns.begin(), columns.end(), [&db](const MarkColumn& a, const MarkColumn& b) {
+            if (a.term != b.term) return a.term < b.term;
+            return db.Str(a.subject) < db.Str(b.subject);
+        });
+        for (size_t c = 0; c < columns.size(); ++c) columnOf[key(columns[c].term, columns[c].subject)] = c;
+
+        out.Put("id,name,father_name,email,phone,class,section,roll,attendance");
+        for (const MarkColumn& c : columns) {
+            out.Put(",T");
+            out.PutNumber(int(c.term));
+            out.Put(':');
+            PutCsv(out, db.Str(c.subject));
+        }
+        out.Put('\n');
+    } else {
+        out.Put("[\n");
+    }
+
+    std::vector<int> scores(columns.size());
+    for (size_t n = 0; n < order.size(); ++n) {
+        if (progress.cancel) return;
+        StudentDbRecord r = db.Record(order[n]);
+        bool marksOk = db.MarksInRange(r);
+        if (csv) {
+            out.PutNumber(r.id);
+            for (uint32_t field : { r.name, r.fatherName, r.email, r.phone, r.className, r.section }) {
+                out.Put(',');
+                PutCsv(out, db.Str(field));
+            }
+            out.Put(',');
+            out.PutNumber(r.rollNumber);
+            out.Put(',');
+            out.PutNumber(r.attendance);
+
+            std::fill(scores.begin(), scores.end(), MarkSheet::kNoMark);
+            for (uint32_t m = r.markFirst; marksOk && m < r.markFirst + r.markCount; ++m) {
+                StudentDbMark mark = db.Mark(m);
+                auto it = columnOf.find(key(mark.term, mark.subject));
+                if (it != columnOf.end()) scores[it->second] = mark.score;
+            }
+            for (int score : scores) {
+                out.Put(',');
+                if (score != MarkSheet::kNoMark) out.PutNumber(score);
+            }
+            out.Put('\n');
+        } else {
+            out.Put(n == 0 ? "{" : ",\n{");
+            PutJsonKey(out, "id", true);        out.PutNumber(r.id);
+            PutJsonKey(out, "name");            PutJson(out, db.Str(r.name));
+            PutJsonKey(out, "father_name");     PutJson(out, db.Str(r.fatherName));
+            PutJsonKey(out, "email");           PutJson(out, db.Str(r.email));
+            PutJsonKey(out, "phone");           PutJson(out, db.Str(r.phone));
+            PutJsonKey(out, "class");           PutJson(out, db.Str(r.className));
+            PutJsonKey(out, "section");         PutJson(out, db.Str(r.section));
+            PutJsonKey(out, "roll");            out.PutNumber(r.rollNumber);
+            PutJsonKey(out, "attendance");      out.PutNumber(r.attendance);
+            PutJsonKey(out, "marks");
+            out.Put('[');
+            bool first = true;
+            for (uint32_t m = r.markFirst; marksOk && m < r.markFirst + r.markCount; ++m) {
+                StudentDbMark mark = db.Mark(m);
+                if (options.term && mark.term != options.term) continue;
+                out.Put(first ? "{" : ",{");
+                first = false;
+                PutJsonKey(out, "term", true);  out.PutNumber(int(mark.term));
+                PutJsonKey(out, "subject");     PutJson(out, db.Str(mark.subject));
+                PutJsonKey(out, "score");       out.PutNumber(mark.score);
+                out.Put('}');
+            }
+            out.Put("]}");
+        }
+        ++progress.rows;
+        ++progress.done;
+    }
+    if (!csv) out.Put(order.empty() ? "]\n" : "\n]\n");
+}
+
+// One row per mark: the long format report cards and spreadsheets pivot from.
+inline void WriteMarks(BufferedWriter& out, const StudentDbView& db, const std::vector<uint32_t>& order,
+                       const ExportOptions& options, ExportProgress& progress) {
+    bool csv = options.format == ExportFormat::Csv;
+    out.Put(csv ? "id,name,class,section,roll,term,subject,score\n" : "[\n");
+    bool first = true;
+    for (uint32_t i : order) {
+        if (progress.cancel) return;
+        StudentDbRecord r = db.Record(i);
+        for (uint32_t m = r.markFirst; db.MarksInRange(r) && m < r.markFirst + r.markCount; ++m) {
+            StudentDbMark mark = db.Mark(m);
+            if (options.term && mark.term != options.term) continue;
+            if (csv) {
+                out.PutNumber(r.id);
+                for (uint32_t field : { r.name, r.className, r.section }) {
+                    out.Put(',');
+                    PutCsv(out, db.Str(field));
+                }
+                out.Put(',');
+                out.PutNumber(r.rollNumber);
+                out.Put(',');
+                out.PutNumber(int(mark.term));
+                out.Put(',');
+                PutCsv(out, db.Str(mark.subject));
+                out.Put(',');
+                out.PutNumber(mark.score);
+                out.Put('\n');
+            } else {
+                out.Put(first ? "{" : ",\n{");
+                PutJsonKey(out, "id", true);    out.PutNumber(r.id);
+                PutJsonKey(out, "name");        PutJson(out, db.Str(r.name));
+                PutJsonKey(out, "class");       PutJson(out, db.Str(r.className));
+                PutJsonKey(out, "section");     PutJson(out, db.Str(r.section));
+                PutJsonKey(out, "roll");        out.PutNumber(r.rollNumber);
+                PutJsonKey(out, "term");        out.PutNumber(int(mark.term));
+                PutJsonKey(out, "subject");     PutJson(out, db.Str(mark.subject));
+                PutJsonKey(out, "score");       out.PutNumber(mark.score);
+                out.Put('}');
+            }
+            first = false;
+            ++progress.rows;
+        }
+        ++progress.done;
+    }
+    if (!csv) out.Put(first ? "]\n" : "\n]\n");
+}
+
+// Finishes an export: closes the file, removes it if the export didn't
+// complete, and publishes the outcome.
+inline void Finish(BufferedWriter& out, const ExportOptions& options, ExportProgress& progress) {
+    bool written = out.Close();
+    if (progress.cancel) {
+        progress.error = "Export cancelled";
+    } else if (!written) {
+        progress.error = "Could not write " + options.path;
+    }
+    if (!progress.error.empty()) std::remove(options.path.c_str());
+    progress.finished.store(true, std::memory_order_release);
+}
+
+} // namespace detail
+
+// Students (one row each, marks as columns or a nested array) or marks (one
+// row per mark) from a mapped students.db.
+inline void ExportStudentDb(std::string_view bytes, const ExportOptions& options, ExportProgress& progress) {
+    detail::StudentDbView db;
+    if (!db.Open(bytes)) {
+        progress.error = "students.db is missing or unreadable";
+        progress.finished.store(true, std::memory_order_release);
+        return;
+    }
+    std::vector<uint32_t> order = detail::SelectStudents(db, options);
+    progress.total = order.size();
+
+    BufferedWriter out(options.path);
+    if (options.dataset == ExportDataset::Marks) detail::WriteMarks(out, db, order, options, progress);
+    else detail::WriteStudents(out, db, order, options, progress);
+    detail::Finish(out, options, progress);
+}
+
+inline void ExportStaff(const std::vector<Staff>& staff, const ExportOptions& options, ExportProgress& progress) {
+    bool csv = options.format == ExportFormat::Csv;
+    progress.total = staff.size();
+    BufferedWriter out(options.path);
+    out.Put(csv ? "id,name,email,phone,role,subject\n" : "[\n");
+    for (size_t n = 0; n < staff.size() && !progress.cancel; ++n) {
+        const Staff& s = staff[n];
+        if (csv) {
+            out.PutNumber(s.getId());
+            for (std::string_view field : { std::string_view(s.getName()), std::string_view(s.getEmail()),
+                                            std::string_view(s.getPhone()), std::string_view(s.getRole()),
+                                            std::string_view(s.getSubject()) }) {
+                out.Put(',');
+                PutCsv(out, field);
+            }
+            out.Put('\n');
+        } else {
+            out.Put(n == 0 ? "{" : ",\n{");
+            PutJsonKey(out, "id", true);    out.PutNumber(s.getId());
+            PutJsonKey(out, "name");        PutJson(out, s.getName());
+            PutJsonKey(out, "email");       PutJson(out, s.getEmail());
+            PutJsonKey(out, "phone");       PutJson(out, s.getPhone());
+            PutJsonKey(out, "role");        PutJson(out, s.getRole());
+            PutJsonKey(out, "subject");     PutJson(out, s.getSubject());
+            out.Put('}');
+        }
+        ++progress.rows;
+        ++progress.done;
+    }
+    if (!csv) out.Put(staff.empty() ? "]\n" : "\n]\n");
+    detail::Finish(out, options, progress);
+}
+
+} // namespace Storage
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Storage {
+
+// Flushes stdio buffers and asks the OS to push the file to disk.
+inline bool SyncFile(FILE* f) {
+    if (std::fflush(f) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(f)) == 0;
+#else
+    return fsync(fileno(f)) == 0;
+#endif
+}
+
+// Atomically replaces `to` with `from` (rename over the old file).
+inline bool ReplaceFile(const std::string& from, const std::string& to) {
+    std::error_code ec;
+    std::filesystem::rename(from, to, ec);
+    return !ec;
+}
+
+} // namespace Storage
@@ -0,0 +1,241 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include "Core/Profiler.h"
+#include "Models/Student.h"
+#include "Storage/FileUtil.h"
+
+namespace Storage {
+
+// students.journal: an append-only log of roster mutations applied on top of
+// the students.db snapshot with the same generation.
+//
+//   JournalHeader
+//   Record: [u32 payload length][u32 crc32 of payload][payload]
+//
+// Every record is an absolute assignment (upsert, delete, set field, set
+// mark), so replaying a journal over a snapshot that already contains it is
+// harmless. Replay stops at the first torn or corrupt record.
+
+constexpr char     kJournalMagic[4] = { 'E', 'S', 'J', 'L' };
+constexpr uint32_t kJournalVersion  = 1;
+
+struct JournalHeader {
+    char     magic[4];
+    uint32_t version;
+    uint64_t generation;
+};
+static_assert(sizeof(JournalHeader) == 16, "JournalHeader layout changed");
+
+enum class JournalOp : uint8_t {
+    PutStudent    = 1,
+    DeleteStudent = 2,
+    SetField      = 3,
+    SetMark       = 4,
+    Batch         = 5, // Nested records (PutString each), applied together
+};
+
+enum class StudentField : uint8_t {
+    Name       = 1,
+    Email      = 2,
+    Phone      = 3,
+    FatherName = 4,
+    ClassName  = 5,
+    Section    = 6,
+    Attendance = 7,
+};
+
+inline uint32_t Crc32(const char* data, size_t len) {
+    static const auto table = [] {
+        struct { uint32_t v[256]; } t;
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t.v[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; ++i)
+        crc = table.v[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// Builds one record payload. Reused between appends to avoid reallocating.
+class JournalRecord {
+public:
+    void Begin(JournalOp op) { bytes.clear(); Put<uint8_t>(static_cast<uint8_t>(op)); }
+
+    template <typename T> void Put(T v) { bytes.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+    void PutString(std::string_view s) { Put<uint32_t>(static_cast<uint32_t>(s.size())); bytes.append(s); }
+
+    const std::string& Payload() const { return bytes; }
+
+private:
+    std::string bytes;
+};
+
+// Sequential decoder over a record payload; any overrun latches ok() to false.
+class JournalReader {
+public:
+    explicit JournalReader(std::string_view payload) : rest(payload) {}
+
+    template <typename T> T Get() {
+        T v{};
+        if (rest.size() < sizeof(T)) { good = false; return v; }
+        std::memcpy(&v, rest.data(), sizeof(T));
+        rest.remove_prefix(sizeof(T));
+        return v;
+    }
+    bool AtEnd() const { return rest.empty(); }
+    std::string_view GetString() {
+        uint32_t len = Get<uint32_t>();
+        if (!good || rest.size() < len) { good = false; return {}; }
+        std::string_view s = rest.substr(0, len);
+        rest.remove_prefix(len);
+        return s;
+    }
+    bool ok() const { return good; }
+
+private:
+    std::string_view rest;
+    bool good = true;
+};
+
+// Accepts a Student or a StudentTable row.
+template <typename StudentLike>
+void EncodePutStudent(JournalRecord& rec, const StudentLike& s) {
+    rec.Begin(JournalOp::PutStudent);
+    rec.Put<int32_t>(s.getId());
+    rec.Put<float>(s.getAttendance());
+    rec.PutString(s.getName());
+    rec.PutString(s.getEmail());
+    rec.PutString(s.getPhone());
+    rec.PutString(s.getClassName());
+    rec.PutString(s.getSection());
+    rec.PutString(s.getFatherName());
+    rec.Put<uint32_t>(static_cast<uint32_t>(s.getMarks().Count()));
+    s.getMarks().ForEach([&rec](int term, Symbol sub, int mark) {
+        rec.Put<uint16_t>(static_cast<uint16_t>(term));
+        rec.PutString(SymbolTable::Get().View(sub));
+        rec.Put<int32_t>(mark);
+    });
+}
+
+inline std::optional<Student> DecodePutStudent(JournalReader& in) {
+    int32_t id = in.Get<int32_t>();
+    float attendance = in.Get<float>();
+    std::string_view name = in.GetString(), email = in.GetString(), phone = in.GetString();
+    std::string_view cls = in.GetString(), sec = in.GetString(), father = in.GetString();
+    if (!in.ok()) return std::nullopt;
+
+    Student s(id, std::string(name), std::string(email), std::string(phone),
+              std::string(cls), std::string(sec), std::string(father));
+    s.setAttendance(attendance);
+    uint32_t count = in.Get<uint32_t>();
+    for (uint32_t i = 0; i < count && in.ok(); ++i) {
+        uint16_t term = in.Get<uint16_t>();
+        std::string_view sub = in.GetString();
+        int32_t mark = in.Get<int32_t>();
+        if (in.ok()) s.setMark(term, SymbolTable::Get().Intern(sub), mark);
+    }
+    if (!in.ok()) return std::nullopt;
+    return s;
+}
+
+// Calls fn(payload) for each intact record in a journal image. Returns the
+// byte length of the valid prefix (0 if the header itself is unusable).
+template <typename Fn>
+size_t ReadJournal(std::string_view bytes, uint64_t& generation, Fn&& fn) {
+    if (bytes.size() < sizeof(JournalHeader)) return 0;
+    JournalHeader h;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    if (std::memcmp(h.magic, kJournalMagic, sizeof(h.magic)) != 0 || h.version != kJournalVersion) return 0;
+    generation = h.generation;
+
+    size_t pos = sizeof(JournalHeader);
+    while (bytes.size() - pos >= 8) {
+        uint32_t len, crc;
+        std::memcpy(&len, bytes.data() + pos, 4);
+        std::memcpy(&crc, bytes.data() + pos + 4, 4);
+        if (bytes.size() - pos - 8 < len) break;
+        const char* payload = bytes.data() + pos + 8;
+        if (Crc32(payload, len) != crc) break;
+        fn(std::string_view(payload, len));
+        pos += 8 + len;
+    }
+    return pos;
+}
+
+// Appends records to the live journal. Each record is handed to the OS as it
+// is written; fsync happens once per kSyncBatch records or on Sync().
+class JournalWriter {
+public:
+    static constexpr int kSyncBatch = 32;
+
+    ~JournalWriter() { Close(); }
+
+    // Opens path for appending. An existing journal for the same generation is
+    // kept (trimmed to validLength); anything else is replaced by a fresh one.
+    bool Open(const std::string& path, uint64_t generation, size_t validLength = 0) {
+        Close();
+        if (validLength >= sizeof(JournalHeader)) {
+            std::error_code ec;
+            std::filesystem::resize_file(path, validLength, ec);
+            if (!ec) file = std::fopen(path.c_str(), "ab");
+            if (file) { bytesWritten = validLength; return true; }
+        }
+
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        JournalHeader h{};
+        std::memcpy(h.magic, kJournalMagic, sizeof(h.magic));
+        h.version = kJournalVersion;
+        h.generation = generation;
+        std::fwrite(&h, sizeof(h), 1, file);
+        bytesWritten = sizeof(h);
+        Profiler::CountBytesWritten(sizeof(h));
+        return SyncFile(file);
+    }
+
+    bool Append(const JournalRecord& rec) {
+        if (!file) return false;
+        const std::string& payload = rec.Payload();
+        uint32_t frame[2] = { static_cast<uint32_t>(payload.size()), Crc32(payload.data(), payload.size()) };
+        bool ok = std::fwrite(frame, sizeof(frame), 1, file) == 1 &&
+                  std::fwrite(payload.data(), 1, payload.size(), file) == payload.size() &&
+                  std::fflush(file) == 0;
+        bytesWritten += sizeof(frame) + payload.size();
+        Profiler::CountBytesWritten(sizeof(frame) + payload.size());
+        if (++unsynced >= kSyncBatch) Sync();
+        return ok;
+    }
+
+    bool Sync() {
+        if (!file || unsynced == 0) return true;
+        unsynced = 0;
+        return SyncFile(file);
+    }
+
+    void Close() {
+        if (!file) return;
+        Sync();
+        std::fclose(file);
+        file = nullptr;
+        bytesWritten = 0;
+    }
+
+    size_t Size() const { return bytesWritten; }
+
+private:
+    FILE* file = nullptr;
+    size_t bytesWritten = 0;
+    int unsynced = 0;
+};
+
+} // namespace Storage
@@ -0,0 +1,137 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+
+namespace Storage {
+
+// Single background thread that performs all disk writes in submission order.
+// Jobs return false on failure. The key names what a job writes: a failure
+// stays reported until a later job with the same key succeeds, so a good
+// write of one file can't hide another that never reached the disk. Callers
+// check IsQueued(key) before queuing a snapshot so a burst of save requests
+// collapses into one write.
+class PersistenceService {
+public:
+    using Job = std::function<bool()>;
+
+    enum class Status { Idle, Saving, Saved, Failed };
+
+    PersistenceService() : worker([this] { WorkerLoop(); }) {}
+
+    ~PersistenceService() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        worker.join();
+    }
+
+    PersistenceService(const PersistenceService&) = delete;
+    PersistenceService& operator=(const PersistenceService&) = delete;
+
+    void Submit(Job job, const char* key = nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back({ key ? key : "", std::move(job) });
+            busy = true;
+        }
+        wake.notify_one();
+    }
+
+    // True if a job with this key is waiting to run (a running one doesn't count).
+    bool IsQueued(const char* key) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& e : queue) if (e.key == key) return true;
+        return false;
+    }
+
+    // Called on the worker thread each time the queue drains.
+    void SetIdleCallback(std::function<void()> fn) {
+        std::lock_guard<std::mutex> lock(mutex);
+        onIdle = std::move(fn);
+    }
+
+    // Blocks until every submitted job has finished. Not for the render loop.
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return !busy; });
+    }
+
+    Status GetStatus() const {
+        if (busy) return Status::Saving;
+        if (failed) return Status::Failed;
+        return completed > 0 ? Status::Saved : Status::Idle;
+    }
+
+    // Seconds since the last job finished (0 if none has).
+    double SecondsSinceLastSave() const {
+        if (completed == 0) return 0.0;
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration<double>(now).count() - lastFinished.load();
+    }
+
+private:
+    struct Entry {
+        std::string key;
+        Job job;
+    };
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) return; // stopping, and everything has been written
+
+            Entry e = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+
+            bool ok = e.job();
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            lastFinished = std::chrono::duration<double>(now).count();
+
+            lock.lock();
+            if (ok) failedKeys.erase(e.key);
+            else failedKeys.insert(e.key);
+            failed = !failedKeys.empty();
+            ++completed;
+            if (queue.empty()) {
+                if (onIdle) {
+                    auto fn = onIdle;
+                    lock.unlock();
+                    fn();
+                    lock.lock();
+                }
+                if (queue.empty()) {
+                    busy = false;
+                    drained.notify_all();
+                }
+            }
+        }
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::deque<Entry> queue;
+    std::function<void()> onIdle;
+    std::unordered_set<std::string> failedKeys; // Of jobs whose last run failed
+    bool stopping = false;
+
+    std::atomic<bool> busy{false};
+    std::atomic<bool> failed{false};
+    std::atomic<unsigned> completed{0};
+    std::atomic<double> lastFinished{0.0};
+
+    std::thread worker; // Declared last so it starts after the members above
+};
+
+} // namespace Storage
@@ -0,0 +1,282 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Core/Profiler.h"
+#include "Core/SymbolTable.h"
+#include "Models/StudentTable.h"
+#include "Storage/FileUtil.h"
+
+namespace Storage {
+
+// students.db binary layout (format version 3, little-endian):
+//
+//   StudentDbHeader
+//   String table   : [u32 length][bytes] ...   (offset 0 is always "")
+//   Record section : StudentDbRecord[recordCount]
+//   Marks section  : StudentDbMark[markCount]
+//
+// Records and marks are fixed width and reference strings by byte offset into
+// the string table, so a mapped file decodes without tokenizing anything.
+// Interned strings (class, section, subject) are stored once and shared by
+// every record that uses them.
+// Version 2 was the old pipe-delimited text file, still readable below.
+
+constexpr char     kStudentDbMagic[4] = { 'E', 'S', 'D', 'B' };
+constexpr uint32_t kStudentDbVersion  = 3;
+
+struct StudentDbHeader {
+    char     magic[4];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t recordSize;
+    uint64_t generation;     // Bumped on every snapshot write
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t recordsOffset;
+    uint64_t marksOffset;
+    uint32_t recordCount;
+    uint32_t markCount;
+};
+static_assert(sizeof(StudentDbHeader) == 64, "StudentDbHeader layout changed");
+
+struct StudentDbRecord {
+    int32_t  id;
+    int32_t  rollNumber;
+    float    attendance;
+    uint32_t name;
+    uint32_t email;
+    uint32_t phone;
+    uint32_t className;
+    uint32_t section;
+    uint32_t fatherName;
+    uint32_t markFirst;
+    uint32_t markCount;
+    uint32_t reserved;
+};
+static_assert(sizeof(StudentDbRecord) == 48, "StudentDbRecord layout changed");
+
+struct StudentDbMark {
+    uint16_t term;
+    uint16_t reserved;
+    uint32_t subject;
+    int32_t  score;
+};
+static_assert(sizeof(StudentDbMark) == 12, "StudentDbMark layout changed");
+
+inline bool IsStudentDb(std::string_view bytes) {
+    return bytes.size() >= sizeof(kStudentDbMagic) &&
+           std::memcmp(bytes.data(), kStudentDbMagic, sizeof(kStudentDbMagic)) == 0;
+}
+
+// Resolves a string table offset. Returns false if the entry runs past the table.
+inline bool ReadDbString(std::string_view table, uint32_t offset, std::string_view& out) {
+    uint32_t len;
+    if (uint64_t(offset) + sizeof(len) > table.size()) return false;
+    std::memcpy(&len, table.data() + offset, sizeof(len));
+    if (uint64_t(offset) + sizeof(len) + len > table.size()) return false;
+    out = table.substr(offset + sizeof(len), len);
+    return true;
+}
+
+// True if `count` items of `itemSize` bytes starting at `offset` lie within
+// `size` bytes. Phrased so that corrupt header values can't wrap around.
+inline bool FitsWithin(uint64_t offset, uint64_t count, uint64_t itemSize, uint64_t size) {
+    return offset <= size && count <= (size - offset) / itemSize;
+}
+
+// Copies out the header of a mapped students.db. Returns false if it isn't
+// this version or any section runs past the end of the file.
+inline bool ReadStudentDbHeader(std::string_view bytes, StudentDbHeader& h) {
+    if (!IsStudentDb(bytes) || bytes.size() < sizeof(StudentDbHeader)) return false;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    return h.version == kStudentDbVersion && h.recordSize == sizeof(StudentDbRecord) &&
+           FitsWithin(h.stringsOffset, h.stringsSize, 1, bytes.size()) &&
+           FitsWithin(h.recordsOffset, h.recordCount, sizeof(StudentDbRecord), bytes.size()) &&
+           FitsWithin(h.marksOffset, h.markCount, sizeof(StudentDbMark), bytes.size());
+}
+
+// Decodes a mapped students.db. Returns false (leaving out untouched) if the
+// header or any offset is inconsistent with the file size.
+inline bool ReadStudentDb(std::string_view bytes, StudentTable& out, uint64_t* generation = nullptr) {
+    StudentDbHeader h;
+    if (!ReadStudentDbHeader(bytes, h)) return false;
+
+    std::string_view table = bytes.substr(h.stringsOffset, h.stringsSize);
+    const char* recordBase = bytes.data() + h.recordsOffset;
+    const char* markBase = bytes.data() + h.marksOffset;
+
+    // Shared string table entries are interned once, not once per record
+    std::unordered_map<uint32_t, Symbol> symbols;
+    auto readSymbol = [&](uint32_t offset, Symbol& out) {
+        auto it = symbols.find(offset);
+        if (it != symbols.end()) { out = it->second; return true; }
+        std::string_view text;
+        if (!ReadDbString(table, offset, text)) return false;
+        out = SymbolTable::Get().Intern(text);
+        symbols.emplace(offset, out);
+        return true;
+    };
+
+    StudentTable decoded;
+    decoded.reserve(h.recordCount);
+    for (uint32_t i = 0; i < h.recordCount; ++i) {
+        StudentDbRecord r;
+        std::memcpy(&r, recordBase + size_t(i) * sizeof(r), sizeof(r));
+
+        std::string_view name, email, phone, father;
+        Symbol cls, sec;
+        if (!ReadDbString(table, r.name, name) || !ReadDbString(table, r.email, email) ||
+            !ReadDbString(table, r.phone, phone) || !readSymbol(r.className, cls) ||
+            !readSymbol(r.section, sec) || !ReadDbString(table, r.fatherName, father))
+            return false;
+        if (uint64_t(r.markFirst) + r.markCount > h.markCount) return false;
+
+        StudentTable::Row s = decoded.Append(r.id, std::string(name), std::string(email), std::string(phone),
+                                             cls, sec, std::string(father));
+        s.setRollNumber(r.rollNumber);
+        s.setAttendance(r.attendance);
+
+        for (uint32_t m = 0; m < r.markCount; ++m) {
+            StudentDbMark mark;
+            std::memcpy(&mark, markBase + size_t(r.markFirst + m) * sizeof(mark), sizeof(mark));
+            Symbol subject;
+            if (!readSymbol(mark.subject, subject)) return false;
+            s.setMark(mark.term, subject, mark.score);
+        }
+    }
+
+    out = std::move(decoded);
+    if (generation) *generation = h.generation;
+    return true;
+}
+
+// Serializes the roster into the version 3 layout.
+inline bool WriteStudentDb(const std::string& path, const StudentTable& students, uint64_t generation = 0) {
+    std::string strings;
+    auto addString = [&strings](std::string_view s) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        uint32_t len = static_cast<uint32_t>(s.size());
+        strings.append(reinterpret_cast<const char*>(&len), sizeof(len));
+        strings.append(s);
+        return offset;
+    };
+    addString(std::string_view());
+
+    // Symbol -> string table offset; 0 (the empty string) means not yet written
+    std::vector<uint32_t> symbolOffsets;
+    auto addSymbol = [&](Symbol sym) {
+        if (sym == kEmptySymbol) return uint32_t(0);
+        if (sym >= symbolOffsets.size()) symbolOffsets.resize(SymbolTable::Get().Size(), 0);
+        uint32_t& offset = symbolOffsets[sym];
+        if (offset == 0) offset = addString(SymbolTable::Get().View(sym));
+        return offset;
+    };
+
+    std::vector<StudentDbRecord> records;
+    std::vector<StudentDbMark> marks;
+    records.reserve(students.size());
+
+    for (int slot = 0; slot < static_cast<int>(students.size()); ++slot) {
+        StudentTable::ConstRow s = students[slot];
+        StudentDbRecord r{};
+        r.id = s.getId();
+        r.rollNumber = s.getRollNumber();
+        r.attendance = s.getAttendance();
+        r.name = addString(s.getName());
+        r.email = addString(s.getEmail());
+        r.phone = addString(s.getPhone());
+        r.className = addSymbol(s.getClassSymbol());
+        r.section = addSymbol(s.getSectionSymbol());
+        r.fatherName = addString(s.getFatherName());
+        r.markFirst = static_cast<uint32_t>(marks.size());
+        s.getMarks().ForEach([&](int term, Symbol sub, int mark) {
+            StudentDbMark m{};
+            m.term = static_cast<uint16_t>(term);
+            m.subject = addSymbol(sub);
+            m.score = mark;
+            marks.push_back(m);
+        });
+        r.markCount = static_cast<uint32_t>(marks.size()) - r.markFirst;
+        records.push_back(r);
+    }
+
+    StudentDbHeader h{};
+    std::memcpy(h.magic, kStudentDbMagic, sizeof(h.magic));
+    h.version = kStudentDbVersion;
+    h.headerSize = sizeof(StudentDbHeader);
+    h.recordSize = sizeof(StudentDbRecord);
+    h.generation = generation;
+    h.stringsOffset = sizeof(StudentDbHeader);
+    h.stringsSize = strings.size();
+    h.recordsOffset = h.stringsOffset + h.stringsSize;
+    h.marksOffset = h.recordsOffset + records.size() * sizeof(StudentDbRecord);
+    h.recordCount = static_cast<uint32_t>(records.size());
+    h.markCount = static_cast<uint32_t>(marks.size());
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(&h, sizeof(h), 1, file) == 1;
+    ok = ok && std::fwrite(strings.data(), 1, strings.size(), file) == strings.size();
+    ok = ok && std::fwrite(records.data(), sizeof(StudentDbRecord), records.size(), file) == records.size();
+    ok = ok && std::fwrite(marks.data(), sizeof(StudentDbMark), marks.size(), file) == marks.size();
+    Profiler::CountBytesWritten(h.marksOffset + marks.size() * sizeof(StudentDbMark));
+    ok = SyncFile(file) && ok;
+    return std::fclose(file) == 0 && ok;
+}
+
+// --- Version 2 (legacy text) ---
+// ID|Name|Email|Phone|Class|Section|RollNo|FatherName|Attendance|Term:Sub:Score;...
+
+inline int ParseInt(std::string_view s) {
+    int v = 0;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+inline void ReadStudentsText(std::string_view bytes, StudentTable& out) {
+    out.clear();
+    while (!bytes.empty()) {
+        size_t eol = bytes.find('\n');
+        std::string_view line = bytes.substr(0, eol);
+        bytes.remove_prefix(eol == std::string_view::npos ? bytes.size() : eol + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        std::string_view parts[10];
+        size_t count = 0;
+        while (count < 10) {
+            size_t bar = line.find('|');
+            parts[count++] = line.substr(0, bar);
+            if (bar == std::string_view::npos) break;
+            line.remove_prefix(bar + 1);
+        }
+        if (count < 9) continue; // Ensure basic fields exist
+
+        Student s(ParseInt(parts[0]), std::string(parts[1]), std::string(parts[2]), std::string(parts[3]),
+                  std::string(parts[4]), std::string(parts[5]), std::string(parts[7]));
+        s.setRollNumber(ParseInt(parts[6]));
+        s.setAttendance(std::strtof(std::string(parts[8]).c_str(), nullptr));
+
+        std::string_view marks = count > 9 ? parts[9] : std::string_view();
+        while (!marks.empty()) {
+            size_t semi = marks.find(';');
+            std::string_view entry = marks.substr(0, semi);
+            marks.remove_prefix(semi == std::string_view::npos ? marks.size() : semi + 1);
+
+            size_t firstColon = entry.find(':');
+            size_t secondColon = entry.rfind(':');
+            if (firstColon == std::string_view::npos || secondColon == firstColon) continue;
+            s.setMark(ParseInt(entry.substr(0, firstColon)),
+                      std::string(entry.substr(firstColon + 1, secondColon - firstColon - 1)),
+                      ParseInt(entry.substr(secondColon + 1)));
+        }
+        out.Append(s);
+    }
+}
+
+} // namespace Storage
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include "imgui.h"
+#include "Models/ClassConfig.h"
+
+// A class + section choice over ClassConfig::Get(), drawn as two combos
+// straight from the config's tables, so a frame copies nothing out of it.
+// The choice is held by ID and re-resolved (by symbol, since IDs restart
+// after ClassConfig::Clear) only when the config's generation changes;
+// adding a class or section elsewhere never moves it. Without `allowAll` the
+// picker always holds the first class and section when there is one; with
+// it, kNoClass / kNoSection mean "All" and the combos list that first.
+class ClassPicker {
+public:
+    explicit ClassPicker(bool allowAll = false) : allowAll(allowAll) {}
+
+    // Each returns true if the user changed the choice. Picking a class
+    // resets the section to the first one, or to "All".
+    bool ClassCombo(const char* label) {
+        Sync();
+        const ClassConfig& config = ClassConfig::Get();
+        bool changed = false;
+        if (ImGui::BeginCombo(label, cls == kNoClass ? Blank() : config.Class(cls).name.c_str())) {
+            if (allowAll && ImGui::Selectable(kAll, cls == kNoClass) && cls != kNoClass) {
+                SelectClass(kNoClass);
+                changed = true;
+            }
+            for (ClassId id : config.Classes()) {
+                bool selected = id == cls;
+                if (ImGui::Selectable(config.Class(id).name.c_str(), selected) && !selected) {
+                    SelectClass(id);
+                    changed = true;
+                }
+                if (selected) ImGui::SetItemDefaultFocus();
+            }
+            ImGui::EndCombo();
+        }
+        return changed;
+    }
+
+    bool SectionCombo(const char* label) {
+        Sync();
+        const ClassConfig& config = ClassConfig::Get();
+        bool changed = false;
+        if (ImGui::BeginCombo(label, section == kNoSection ? Blank() : config.Section(section).name.c_str())) {
+            if (allowAll && ImGui::Selectable(kAll, section == kNoSection) && section != kNoSection) {
+                SelectSection(kNoSection);
+                changed = true;
+            }
+            if (cls != kNoClass) {
+                for (SectionId id : config.Sections(cls)) {
+                    bool selected = id == section;
+                    if (ImGui::Selectable(config.Section(id).name.c_str(), selected) && !selected) {
+                        SelectSection(id);
+                        changed = true;
+                    }
+                    if (selected) ImGui::SetItemDefaultFocus();
+                }
+            }
+            ImGui::EndCombo();
+        }
+        return changed;
+    }
+
+    ClassId Class() { Sync(); return cls; }
+    SectionId Section() { Sync(); return section; }
+    // kNoSymbol when nothing (or "All") is chosen.
+    Symbol ClassSymbol() { Sync(); return classSymbol; }
+    Symbol SectionSymbol() { Sync(); return sectionSymbol; }
+
+    // Back to the first class and section (or "All").
+    void Reset() {
+        classSymbol = sectionSymbol = kNoSymbol;
+        generation = UINT64_MAX;
+    }
+
+private:
+    static constexpr const char* kAll = "All";
+
+    const char* Blank() const { return allowAll ? kAll : ""; }
+
+    void Sync() {
+        const ClassConfig& config = ClassConfig::Get();
+        if (generation == config.Generation()) return;
+        generation = config.Generation();
+        cls = config.FindClass(classSymbol);
+        if (cls == kNoClass && !allowAll && !config.Classes().empty()) cls = config.Classes().front();
+        section = cls == kNoClass ? kNoSection : config.FindSection(cls, sectionSymbol);
+        if (section == kNoSection && !allowAll && cls != kNoClass && !config.Sections(cls).empty())
+            section = config.Sections(cls).front();
+        Remember();
+    }
+
+    void SelectClass(ClassId id) {
+        const ClassConfig& config = ClassConfig::Get();
+        cls = id;
+        section = kNoSection;
+        if (!allowAll && cls != kNoClass && !config.Sections(cls).empty()) section = config.Sections(cls).front();
+        Remember();
+    }
+
+    void SelectSection(SectionId id) {
+        section = id;
+        Remember();
+    }
+
+    void Remember() {
+        const ClassConfig& config = ClassConfig::Get();
+        classSymbol = cls == kNoClass ? kNoSymbol : config.Class(cls).symbol;
+        sectionSymbol = section == kNoSection ? kNoSymbol : config.Section(section).symbol;
+    }
+
+    bool allowAll;
+    ClassId cls = kNoClass;
+    SectionId section = kNoSection;
+    Symbol classSymbol = kNoSymbol;
+    Symbol sectionSymbol = kNoSymbol;
+    uint64_t generation = UINT64_MAX; // Config generation cls and section were resolved against
+};
@@ -0,0 +1,64 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <utility>
+#include "imgui.h"
+
+// The one "are you sure?" modal behind every destructive or bulk row action.
+// A row button only calls Ask() with what to do; nothing about the dialog is
+// submitted per row. Render() runs once per frame outside every table, so
+// the popup has a single ID and the confirmed action runs after the tables
+// are done, when it can no longer invalidate a view mid-loop.
+class ConfirmDialog {
+public:
+    // `body`, if given, draws extra widgets under the message (a target
+    // picker, say) and returns whether the action can be confirmed yet.
+    void Ask(std::string title, std::string message, const char* confirmLabel,
+             std::function<void()> onConfirm, std::function<bool()> body = nullptr) {
+        windowTitle = std::move(title) + kPopupId; // Shown as the title; the ID is kPopupId alone
+        this->message = std::move(message);
+        this->confirmLabel = confirmLabel;
+        this->onConfirm = std::move(onConfirm);
+        this->body = std::move(body);
+        openRequested = true;
+    }
+
+    void Render() {
+        if (openRequested) {
+            ImGui::OpenPopup(kPopupId);
+            openRequested = false;
+        }
+        if (!onConfirm) return;
+        ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+        if (!ImGui::BeginPopupModal(windowTitle.c_str(), nullptr, ImGuiWindowFlags_AlwaysAutoResize)) return;
+
+        ImGui::TextUnformatted(message.c_str());
+        bool enabled = body ? body() : true;
+        ImGui::Separator();
+
+        bool confirmed = false;
+        ImGui::BeginDisabled(!enabled);
+        if (ImGui::Button(confirmLabel, ImVec2(100, 0))) confirmed = true;
+        ImGui::EndDisabled();
+        ImGui::SameLine();
+        bool cancelled = ImGui::Button("Cancel", ImVec2(100, 0)) || ImGui::IsKeyPressed(ImGuiKey_Escape, false);
+        if (confirmed || cancelled) {
+            std::function<void()> action = std::move(onConfirm);
+            onConfirm = nullptr;
+            body = nullptr;
+            ImGui::CloseCurrentPopup();
+            if (confirmed) action();
+        }
+        ImGui::EndPopup();
+    }
+
+private:
+    static constexpr const char* kPopupId = "###ConfirmRowAction";
+
+    std::string windowTitle;
+    std::string message;
+    const char* confirmLabel = "Yes";
+    std::function<void()> onConfirm;
+    std::function<bool()> body;
+    bool openRequested = false;
+};
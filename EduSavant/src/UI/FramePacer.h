@@ -0,0 +1,75 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <GLFW/glfw3.h>
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "UI/FrameSettings.h"
+
+// Decides when the render loop draws. In power-saving mode the loop sleeps
+// in glfwWaitEventsTimeout until there is input, a window needs repainting,
+// or background work calls RequestFrame(); after each of those it draws a
+// few frames so ImGui can settle (hover, popups opening, layout) and then
+// goes back to sleep. An optional frame-rate cap applies in both modes.
+class FramePacer {
+public:
+    // Reads `settings` every frame, so changes apply immediately.
+    explicit FramePacer(const FrameSettings& settings) : settings(settings) {}
+
+    // Repaints and resizes of the main window count as reasons to draw.
+    void Attach(GLFWwindow* window) {
+        glfwSetWindowRefreshCallback(window, [](GLFWwindow*) { RequestFrame(); });
+        glfwSetFramebufferSizeCallback(window, [](GLFWwindow*, int, int) { RequestFrame(); });
+    }
+
+    // Safe from any thread: wakes the loop for at least one more frame.
+    static void RequestFrame() {
+        requested.store(true);
+        glfwPostEmptyEvent();
+    }
+
+    // Call at the top of the loop, in place of glfwPollEvents(). While
+    // `animating` (a progress bar is on screen) idle frames come at ~30 fps.
+    void WaitForFrame(GLFWwindow* window, bool animating = false) {
+        ThrottleToCap();
+        if (!settings.powerSaving) {
+            glfwPollEvents();
+            lastFrame = Clock::now();
+            return;
+        }
+        if (framesLeft > 0) {
+            glfwPollEvents();
+        } else if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+            glfwWaitEvents(); // Nothing on screen to keep current
+        } else {
+            // A focused text field keeps its cursor blinking; otherwise wake
+            // once a second so "saved Ns ago" style text stays roughly current.
+            double timeout = animating ? kAnimationTimeout : ImGui::GetIO().WantTextInput ? kBlinkTimeout : kIdleTimeout;
+            glfwWaitEventsTimeout(timeout);
+        }
+        if (requested.exchange(false) || ImGui::GetCurrentContext()->InputEventsQueue.Size > 0)
+            framesLeft = kSettleFrames;
+        else if (framesLeft > 0)
+            --framesLeft;
+        lastFrame = Clock::now();
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int kSettleFrames = 3;
+    static constexpr double kIdleTimeout = 1.0;
+    static constexpr double kBlinkTimeout = 0.2;
+    static constexpr double kAnimationTimeout = 1.0 / 30.0;
+
+    void ThrottleToCap() const {
+        if (settings.maxFps <= 0) return;
+        auto next = lastFrame + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / settings.maxFps));
+        if (Clock::now() < next) std::this_thread::sleep_until(next);
+    }
+
+    const FrameSettings& settings;
+    static inline std::atomic<bool> requested{false};
+    int framesLeft = kSettleFrames; // Draw the first frames unconditionally
+    Clock::time_point lastFrame = Clock::now();
+};
@@ -0,0 +1,8 @@
+#pragma once
+
+// The user's frame pacing choices (Settings > Performance). Separate from
+// FramePacer so the screens that edit them don't depend on GLFW.
+struct FrameSettings {
+    bool powerSaving = true;
+    int maxFps = 0; // 0 = no cap beyond vsync
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "imgui.h"
+#include "Core/Profiler.h"
+
+// Dockable "Profiler" window: frame-time graph, the per-scope breakdown,
+// allocation and disk-write counters, and Chrome trace capture. The
+// profiler only measures while this window is open or a trace is recording.
+// A stopped trace is written out on its own thread.
+class ProfilerOverlay {
+public:
+    bool open = false;
+
+    ~ProfilerOverlay() {
+        if (traceSave) traceSave->writer.join();
+    }
+
+    // A trace is being written; the render loop should keep drawing frames.
+    bool Saving() const { return traceSave != nullptr; }
+
+    void Render() {
+        Profiler& profiler = Profiler::Get();
+        profiler.SetEnabled(open);
+        if (traceSave && traceSave->finished.load(std::memory_order_acquire)) {
+            traceSave->writer.join();
+            traceMessage = (traceSave->ok ? "Saved " : "Could not write ") + traceSave->path;
+            if (traceSave->trace.dropped) traceMessage += " (" + std::to_string(traceSave->trace.dropped) + " events dropped)";
+            traceSave.reset();
+        }
+        if (!open) return;
+
+        ImGui::SetNextWindowSize(ImVec2(560, 620), ImGuiCond_FirstUseEver);
+        if (!ImGui::Begin("Profiler", &open)) {
+            ImGui::End();
+            return;
+        }
+
+        // Frame times
+        std::vector<float> history = profiler.FrameHistory();
+        float worst = history.empty() ? 0.0f : *std::max_element(history.begin(), history.end());
+        float mean = 0.0f;
+        for (float ms : history) mean += ms;
+        if (!history.empty()) mean /= history.size();
+        const Profiler::Frame& last = profiler.LastFrame();
+        ImGui::Text("Frame %.2f ms   avg %.2f   max %.2f", last.ms, mean, worst);
+        ImGui::PlotLines("##frame_times", history.data(), static_cast<int>(history.size()), 0, nullptr,
+                         0.0f, std::max(worst, 16.7f), ImVec2(-1, 80));
+        ImGui::TextDisabled("Work per drawn frame; idle waits are not counted.");
+
+        ImGui::Text("Allocations: %zu (%.1f KB) this frame", last.allocations, last.allocatedBytes / 1024.0);
+        ImGui::Text("Written to disk: %.1f KB this frame, %.2f MB while profiling",
+                    last.bytesWritten / 1024.0, profiler.TotalBytesWritten() / (1024.0 * 1024.0));
+        ImGui::Spacing();
+
+        // Chrome trace
+        if (traceSave) {
+            ImGui::TextDisabled("Saving %s (%zu events)...", traceSave->path.c_str(), traceSave->trace.events.size());
+        } else if (!profiler.Tracing()) {
+            ImGui::SetNextItemWidth(260);
+            ImGui::InputText("##trace_path", tracePath, sizeof(tracePath));
+            ImGui::SameLine();
+            if (ImGui::Button("Record trace")) {
+                profiler.StartTrace();
+                traceMessage.clear();
+            }
+        } else {
+            ImGui::TextColored(ImVec4(0.9f, 0.6f, 0.2f, 1.0f), "Recording: %zu events", profiler.TraceEventCount());
+            ImGui::SameLine();
+            if (ImGui::Button("Stop and save")) {
+                traceSave = std::make_unique<TraceSave>();
+                traceSave->path = tracePath;
+                traceSave->trace = profiler.StopTrace();
+                traceSave->writer = std::thread([save = traceSave.get()] {
+                    save->ok = Profiler::WriteTrace(save->trace, save->path);
+                    save->finished.store(true, std::memory_order_release);
+                });
+                traceMessage.clear();
+            }
+        }
+        if (!traceMessage.empty()) ImGui::TextDisabled("%s", traceMessage.c_str());
+        ImGui::Spacing();
+
+        // Per-scope breakdown
+        if (ImGui::Button("Reset peaks")) profiler.ResetPeaks();
+        if (ImGui::BeginTable("profiler_scopes", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("Thread");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Last ms");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("Peak ms");
+            ImGui::TableHeadersRow();
+            for (const Profiler::ScopeStats& s : profiler.Scopes()) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(s.name);
+                ImGui::TableNextColumn();
+                if (s.uiThread) ImGui::TextUnformatted("UI");
+                else ImGui::Text("Worker %d", s.thread);
+                ImGui::TableNextColumn(); ImGui::Text("%u", s.calls);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", s.lastMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", s.avgMs);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", s.peakMs);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+    }
+
+private:
+    struct TraceSave {
+        std::string path;
+        Profiler::Trace trace;
+        bool ok = false; // Valid once finished
+        std::atomic<bool> finished{false};
+        std::thread writer;
+    };
+
+    char tracePath[260] = "trace.json";
+    std::string traceMessage;
+    std::unique_ptr<TraceSave> traceSave; // Writing a stopped trace
+};